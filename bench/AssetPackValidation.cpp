@@ -0,0 +1,154 @@
+// Writes a small asset pack, checks its assets read back, then damages its
+// index in the ways a corrupt or hostile pack could & checks each damaged
+// pack is rejected by open rather than read out of bounds by find. Exits
+// non-zero if any of them isn't.
+
+#include "AssetPack.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+// Matches the native endian layout AssetPack writes, a 16 byte header then
+// 24 byte entries sorted by path
+constexpr std::size_t HEADER_SIZE { 16 };
+constexpr std::size_t ENTRY_SIZE { 24 };
+constexpr std::size_t ENTRY_OFFSET { 0 };
+constexpr std::size_t ENTRY_STORED_SIZE { 8 };
+constexpr std::size_t ENTRY_SIZE_FIELD { 12 };
+constexpr std::size_t ENTRY_COMPRESSION { 22 };
+
+using Bytes = std::vector<char>;
+
+auto read_bytes(const std::filesystem::path& path) -> Bytes
+{
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+void write_bytes(const std::filesystem::path& path, const Bytes& bytes)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+template <typename T>
+void poke(Bytes& bytes, std::size_t entry, std::size_t field, T value)
+{
+    std::memcpy(bytes.data() + HEADER_SIZE + entry * ENTRY_SIZE + field, &value, sizeof(value));
+}
+
+template <typename T>
+auto peek(const Bytes& bytes, std::size_t entry, std::size_t field) -> T
+{
+    T value;
+    std::memcpy(&value, bytes.data() + HEADER_SIZE + entry * ENTRY_SIZE + field, sizeof(value));
+    return value;
+}
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path() / "impossible-rocket-pack-test";
+    const auto packPath = dir / "assets.pack";
+    int failures = 0;
+    try {
+        std::filesystem::create_directories(dir);
+        // One entry LZ4 compresses, the other is too random to & stays raw
+        const auto compressiblePath = (dir / "a_repeats.bin").generic_string();
+        const auto rawPath = (dir / "b_noise.bin").generic_string();
+        const std::string compressible(4096, 'r');
+        std::string raw(509, '\0');
+        std::uint32_t state = 0x9e3779b9;
+        for (auto& c : raw) {
+            state = state * 1664525u + 1013904223u;
+            c = static_cast<char>(state >> 24);
+        }
+        write_bytes(compressiblePath, { compressible.begin(), compressible.end() });
+        write_bytes(rawPath, { raw.begin(), raw.end() });
+        AssetPack::write(packPath, { compressiblePath, rawPath });
+
+        {
+            AssetPack pack;
+            pack.open(packPath);
+            const auto a = pack.find(compressiblePath);
+            const auto b = pack.find(rawPath);
+            if (!a || !b || std::string(reinterpret_cast<const char*>(a->data), a->size) != compressible
+                || std::string(reinterpret_cast<const char*>(b->data), b->size) != raw) {
+                throw std::runtime_error("The packed assets don't read back as written");
+            }
+        }
+
+        const auto valid = read_bytes(packPath);
+        const auto fileSize = static_cast<std::uint64_t>(valid.size());
+        if (peek<std::uint16_t>(valid, 0, ENTRY_COMPRESSION) == 0
+            || peek<std::uint16_t>(valid, 1, ENTRY_COMPRESSION) != 0) {
+            throw std::runtime_error("Expected the first entry compressed & the second raw");
+        }
+        const auto rawOffset = peek<std::uint64_t>(valid, 1, ENTRY_OFFSET);
+
+        struct Case {
+            const char* name;
+            std::function<void(Bytes&)> damage;
+        };
+        const std::vector<Case> cases {
+            { "an uncompressed entry whose size isn't its stored size",
+              [](Bytes& b) { poke<std::uint32_t>(b, 1, ENTRY_SIZE_FIELD, 4096); } },
+            { "an unknown compression", [](Bytes& b) { poke<std::uint16_t>(b, 0, ENTRY_COMPRESSION, 7); } },
+            // offset + storedSize wraps to a small number
+            { "an offset near the top of the range",
+              [](Bytes& b) {
+                  poke<std::uint64_t>(b, 1, ENTRY_OFFSET, std::numeric_limits<std::uint64_t>::max() - 15);
+              } },
+            { "an offset past the end of the file",
+              [&](Bytes& b) { poke<std::uint64_t>(b, 1, ENTRY_OFFSET, fileSize + 1); } },
+            { "a stored size running past the end of the file",
+              [&](Bytes& b) {
+                  const auto storedSize = static_cast<std::uint32_t>(fileSize - rawOffset + 1);
+                  poke<std::uint32_t>(b, 1, ENTRY_STORED_SIZE, storedSize);
+                  poke<std::uint32_t>(b, 1, ENTRY_SIZE_FIELD, storedSize);
+              } },
+            { "a truncated file", [](Bytes& b) { b.resize(b.size() - 1); } },
+        };
+
+        for (const auto& c : cases) {
+            auto damaged = valid;
+            c.damage(damaged);
+            write_bytes(packPath, damaged);
+            AssetPack pack;
+            try {
+                pack.open(packPath);
+                spdlog::error("Opened a pack with {}", c.name);
+                ++failures;
+            } catch (const std::exception& e) {
+                if (pack.isOpen()) {
+                    spdlog::error("Rejected a pack with {} but left it open", c.name);
+                    ++failures;
+                } else {
+                    spdlog::info("Rejected {}: {}", c.name, e.what());
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+        failures = 1;
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(dir, error);
+    if (failures > 0)
+        return 1;
+    spdlog::info("Every damaged pack was rejected");
+    return 0;
+}
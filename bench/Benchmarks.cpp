@@ -0,0 +1,190 @@
+// Google Benchmark suite over the simulation's hot paths. Run it with
+// --benchmark_out=<file> --benchmark_out_format=json & compare two runs with
+// Google Benchmark's tools/compare.py to catch regressions between commits.
+// Levels are generated into the temp directory so the planet count can vary,
+// & deleted afterwards.
+
+#include "GameLevel.hpp"
+#include "ParticleSystem.hpp"
+#include "PhysicsWorld.hpp"
+#include "ThreadPool.hpp"
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <spdlog/fmt/fmt.h>
+#include <vector>
+
+constexpr float LEVEL_SIZE { 20000.0f };
+constexpr float PLANET_RADIUS { 10.0f };
+constexpr std::size_t QUERY_COUNT { 1024 };
+constexpr float ROCKET_RADIUS { 8.0f };
+constexpr float ROCKET_MASS { 1.0e5f };
+constexpr auto TIME_STEP { sf::microseconds(8333) };
+constexpr auto FRAME_TIME { sf::microseconds(16667) };
+constexpr std::uint32_t PARTICLE_SEED { 1234 };
+
+namespace {
+// A level with planetCount planets scattered over the level, deleted along
+// with its compiled form when the benchmark is done with it
+class TempLevel {
+public:
+    explicit TempLevel(std::size_t planetCount)
+        : m_path(std::filesystem::temp_directory_path() / fmt::format("impossible-rocket-bench-{}.txt", planetCount))
+    {
+        std::default_random_engine engine(1234);
+        std::uniform_real_distribution<float> positionDist(0.0f, LEVEL_SIZE);
+        std::uniform_real_distribution<float> massDist(1.0e15f, 1.0e17f);
+
+        std::ofstream file(m_path, std::ios::trunc);
+        file << "s " << LEVEL_SIZE / 2.0f << ' ' << LEVEL_SIZE / 2.0f << '\n';
+        for (std::size_t i = 0; i < planetCount; ++i) {
+            file << "p " << PLANET_RADIUS << ' ' << positionDist(engine) << ' ' << positionDist(engine) << ' '
+                 << massDist(engine) << '\n';
+        }
+        file << "o " << LEVEL_SIZE / 4.0f << ' ' << LEVEL_SIZE / 4.0f << '\n';
+    }
+
+    ~TempLevel()
+    {
+        std::error_code error;
+        std::filesystem::remove(m_path, error);
+        std::filesystem::remove(GameLevel::getCompiledPath(m_path), error);
+    }
+
+    TempLevel(const TempLevel&) = delete;
+    TempLevel& operator=(const TempLevel&) = delete;
+
+    auto getPath() const -> const std::filesystem::path& { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+};
+
+auto random_points(std::size_t count) -> std::vector<sf::Vector2f>
+{
+    std::default_random_engine engine(5678);
+    std::uniform_real_distribution<float> positionDist(0.0f, LEVEL_SIZE);
+    std::vector<sf::Vector2f> points(count);
+    for (auto& p : points)
+        p = { positionDist(engine), positionDist(engine) };
+    return points;
+}
+
+void set_planet_counts(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(8)->Range(8, 4096);
+}
+}
+
+// One fixed step per iteration, through step so the integrator kernel is the real one
+static void BM_PhysicsIntegrate(benchmark::State& state)
+{
+    const auto bodyCount = static_cast<std::size_t>(state.range(0));
+    std::default_random_engine engine(1234);
+    std::uniform_real_distribution<float> positionDist(0.0f, LEVEL_SIZE);
+    std::uniform_real_distribution<float> velocityDist(-400.0f, 400.0f);
+
+    PhysicsWorld world;
+    for (std::size_t i = 0; i < bodyCount; ++i) {
+        const auto body = world.addBody(ROCKET_MASS, 1.0e3f);
+        world.setPosition(body, { positionDist(engine), positionDist(engine) });
+        world.setLinearVelocity(body, { velocityDist(engine), velocityDist(engine) });
+    }
+
+    for (auto _ : state) {
+        world.step(TIME_STEP, TIME_STEP);
+        auto position = world.getPosition(0);
+        benchmark::DoNotOptimize(position);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PhysicsIntegrate)->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BM_SummedForce(benchmark::State& state)
+{
+    GameLevel level;
+    const TempLevel tempLevel(static_cast<std::size_t>(state.range(0)));
+    level.loadLevel(tempLevel.getPath());
+    const auto points = random_points(QUERY_COUNT);
+
+    for (auto _ : state) {
+        for (const auto& p : points) {
+            auto force = level.getSummedForce(p, ROCKET_MASS);
+            benchmark::DoNotOptimize(force);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points.size()));
+}
+BENCHMARK(BM_SummedForce)->Apply(set_planet_counts);
+
+// Sweeps about as long as a fast rocket's step
+static void BM_CollideWithPlanet(benchmark::State& state)
+{
+    GameLevel level;
+    const TempLevel tempLevel(static_cast<std::size_t>(state.range(0)));
+    level.loadLevel(tempLevel.getPath());
+    const auto points = random_points(QUERY_COUNT);
+
+    for (auto _ : state) {
+        for (const auto& p : points) {
+            auto collision = level.doesCollideWithPlanet(p, p + sf::Vector2f { 5.0f, 3.0f }, ROCKET_RADIUS);
+            benchmark::DoNotOptimize(collision);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points.size()));
+}
+BENCHMARK(BM_CollideWithPlanet)->Apply(set_planet_counts);
+
+// Parsing the text plus building the query structures, as a level load does
+static void BM_LoadLevel(benchmark::State& state)
+{
+    const TempLevel tempLevel(static_cast<std::size_t>(state.range(0)));
+    GameLevel level;
+
+    for (auto _ : state)
+        level.loadLevel(tempLevel.getPath());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadLevel)->Apply(set_planet_counts);
+
+static void BM_LoadCompiledLevel(benchmark::State& state)
+{
+    const TempLevel tempLevel(static_cast<std::size_t>(state.range(0)));
+    const auto path = GameLevel::getCompiledPath(tempLevel.getPath());
+    GameLevel::compileLevel(tempLevel.getPath(), path);
+    GameLevel level;
+
+    for (auto _ : state)
+        level.loadLevel(path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadCompiledLevel)->Apply(set_planet_counts);
+
+// One frame of an effect at its busiest, bursts are refired as they fade &
+// the exhaust emits continuously. Without a texture the system has nothing
+// to draw & skips its vertex buffers, so no graphics context is created.
+static void BM_ParticleUpdate(benchmark::State& state)
+{
+    const auto type = static_cast<ParticleSystem::Type>(state.range(0));
+    ParticleSystem particles(ThreadPool::get(), PARTICLE_SEED, { nullptr, { { 0, 0 }, { 64, 64 } } });
+    const bool isBurst = type != ParticleSystem::Type::Rocket_Exhaust;
+    if (!isBurst)
+        particles.start(type);
+
+    std::int64_t particlesUpdated = 0;
+    for (auto _ : state) {
+        if (isBurst && particles.getParticleCount(type) == 0)
+            particles.burst(type, { 400.0f, 300.0f }, { 0.0f, -1.0f });
+        particles.update(FRAME_TIME);
+        particlesUpdated += static_cast<std::int64_t>(particles.getParticleCount(type));
+    }
+    state.SetItemsProcessed(particlesUpdated);
+}
+BENCHMARK(BM_ParticleUpdate)
+    ->ArgName("type")
+    ->DenseRange(0, static_cast<int>(ParticleSystem::Type::MAX_TYPE) - 1)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,130 @@
+// Plays level one through the game's real frame, the same update & draw
+// App::run does with PlayState, in a hidden window, & counts heap
+// allocations made by each frame once the game has warmed up. Input is
+// scripted so the rocket thrusts, turns, crashes & resets. Exits non-zero
+// if any steady state frame allocates, & with SKIP_EXIT_CODE when there's
+// no display to open the window on.
+
+#include "AssetHolder.hpp"
+#include "FrameArena.hpp"
+#include "GraphicsContext.hpp"
+#include "InputHandler.hpp"
+#include "PlayState.hpp"
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <imgui-SFML.h>
+#include <new>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+constexpr std::size_t WARM_UP_FRAMES { 300 };
+constexpr std::size_t MEASURED_FRAMES { 1200 };
+constexpr float FRAME_TIME { 1.0f / 60.0f };
+
+std::atomic<std::size_t> g_allocationCount { 0 };
+
+// The replacements below pair malloc with free, but GCC sees free called on
+// memory from operator new once it inlines them & warns
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    ++g_allocationCount;
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+// Thrust in bursts while turning one way, then the other, then not at all
+auto get_input(std::size_t frame) -> InputState
+{
+    InputState input;
+    input.linear_thrust = (frame / 45) % 2 == 0 ? 1.0f : 0.0f;
+    input.angular_thrust = static_cast<float>((frame / 90) % 3) - 1.0f;
+    return input;
+}
+
+int main()
+{
+    if (!has_display()) {
+        spdlog::warn("No display to open the window on, skipping");
+        return SKIP_EXIT_CODE;
+    }
+
+    sf::RenderWindow window;
+    window.create(sf::VideoMode({ 800, 600 }), "Impossible Rocket - Frame Allocations");
+    window.setVisible(false);
+    if (!ImGui::SFML::Init(window)) {
+        spdlog::error("Unable to initialise ImGui SFML");
+        return 1;
+    }
+
+    // The singletons App creates at startup
+    InputHandler::get();
+    AssetHolder::get();
+    ThreadPool::get();
+    FrameArena::get();
+    Profiler::get();
+
+    std::size_t allocations = 0;
+    std::size_t allocatingFrames = 0;
+    std::optional<std::size_t> firstAllocatingFrame;
+    {
+        PlayState state(window);
+        state.enter();
+
+        // The profiler panel's stats, fetched the way App's panel does
+        std::vector<Profiler::ZoneStats> zoneStats;
+        const auto frameTime = sf::seconds(FRAME_TIME);
+        const auto runFrame = [&](std::size_t frame) {
+            FrameArena::get().reset();
+            AssetHolder::get().uploadPendingTextures();
+            InputHandler::get().handleEvents(window);
+            InputHandler::get().setInputState(get_input(frame));
+            ImGui::SFML::Update(window, frameTime);
+            Profiler::get().getZoneStats(zoneStats);
+
+            state.update(frameTime);
+            window.clear();
+            state.draw();
+            ImGui::SFML::Render(window);
+            window.display();
+            PROFILE_END_FRAME();
+        };
+
+        for (std::size_t frame = 0; frame < WARM_UP_FRAMES; ++frame)
+            runFrame(frame);
+
+        for (std::size_t frame = WARM_UP_FRAMES; frame < WARM_UP_FRAMES + MEASURED_FRAMES; ++frame) {
+            const auto frameStart = g_allocationCount.load();
+            runFrame(frame);
+            const auto frameAllocations = g_allocationCount.load() - frameStart;
+            if (frameAllocations > 0) {
+                allocations += frameAllocations;
+                ++allocatingFrames;
+                if (!firstAllocatingFrame)
+                    firstAllocatingFrame = frame;
+            }
+        }
+    }
+    ImGui::SFML::Shutdown(window);
+
+    spdlog::info("{} allocations in {} of {} frames", allocations, allocatingFrames, MEASURED_FRAMES);
+    if (firstAllocatingFrame)
+        spdlog::error("Steady state frames allocate, the first was frame {}", *firstAllocatingFrame);
+    return allocations == 0 ? 0 : 1;
+}
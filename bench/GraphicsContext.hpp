@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdlib>
+
+// ctest reports a test that exits with this as skipped, see SKIP_RETURN_CODE
+constexpr int SKIP_EXIT_CODE { 77 };
+
+// SFML aborts rather than failing when it can't open an X display, so tests
+// that need a graphics context check for one before creating anything
+inline auto has_display() -> bool
+{
+#if defined(__unix__) && !defined(__APPLE__)
+    return std::getenv("DISPLAY") != nullptr;
+#else
+    return true;
+#endif
+}
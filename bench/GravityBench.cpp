@@ -0,0 +1,191 @@
+// Times the Barnes-Hut gravity tree and the baked gravity field against the
+// exact per planet sum and checks their error stays within bounds. Exits
+// non-zero if the error at the default opening angle is too large, or if a
+// coarse field is interpolated across a planet.
+
+#include "GameplayBlackboard.hpp"
+#include "GravityField.hpp"
+#include "GravityTree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+constexpr std::size_t PLANET_COUNT { 5000 };
+constexpr std::size_t QUERY_COUNT { 10000 };
+constexpr float PLANET_RADIUS { 10.0f };
+constexpr float FIELD_CELL_SIZE { 20.0f };
+// The smallest planet in bin/levels under a field with much bigger cells
+constexpr std::size_t SMALL_PLANET_COUNT { 200 };
+constexpr float SMALL_PLANET_RADIUS { 16.0f };
+constexpr float COARSE_CELL_SIZE { 128.0f };
+// Worst error allowed at bb::BARNES_HUT_THETA. The error is measured against
+// the summed magnitude of every planet's pull rather than the net field, which
+// can cancel out to almost nothing between planets.
+constexpr double MAX_ERROR { 0.01 };
+
+struct ExactField {
+    sf::Vector2f field;
+    float magnitudeSum { 0.0f };
+};
+
+auto exact_field(const std::vector<GravityTree::Mass>& masses, const sf::Vector2f& position) -> ExactField
+{
+    ExactField result;
+    for (const auto& m : masses) {
+        const auto delta = m.position - position;
+        const float radiusSq = delta.lengthSq();
+        result.field += (delta / std::sqrt(radiusSq)) * (m.mass / radiusSq);
+        result.magnitudeSum += m.mass / radiusSq;
+    }
+    return result;
+}
+
+template <typename Func>
+auto time_ms(Func&& func) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    // Planets scattered over a large level, queries spread over the same area
+    // and kept clear of the planets like a rocket would be
+    std::default_random_engine engine(1234);
+    std::uniform_real_distribution<float> positionDist(0.0f, 20000.0f);
+    std::uniform_real_distribution<float> massDist(1.0e15f, 1.0e17f);
+
+    std::vector<GravityTree::Mass> masses(PLANET_COUNT);
+    for (auto& m : masses)
+        m = { { positionDist(engine), positionDist(engine) }, massDist(engine) };
+
+    std::vector<sf::Vector2f> queries;
+    while (queries.size() < QUERY_COUNT) {
+        const sf::Vector2f position { positionDist(engine), positionDist(engine) };
+        const auto isClear = std::none_of(masses.begin(), masses.end(), [&position](const auto& m) {
+            return (m.position - position).lengthSq() < 2.0f * PLANET_RADIUS * 2.0f * PLANET_RADIUS;
+        });
+        if (isClear)
+            queries.push_back(position);
+    }
+
+    std::vector<ExactField> exact(QUERY_COUNT);
+    const auto exactTime = time_ms([&] {
+        for (std::size_t i = 0; i < QUERY_COUNT; ++i)
+            exact[i] = exact_field(masses, queries[i]);
+    });
+    spdlog::info("{} planets, {} queries", PLANET_COUNT, QUERY_COUNT);
+    spdlog::info("Exact        | {:8.3f} ms", exactTime);
+
+    GravityTree tree;
+    const auto buildTime = time_ms([&] { tree.build(masses); });
+    spdlog::info("Tree build   | {:8.3f} ms | {} nodes", buildTime, tree.getNodeCount());
+
+    bool withinBounds = true;
+    for (const auto theta : { 0.3f, bb::BARNES_HUT_THETA, 0.7f, 1.0f }) {
+        tree.setTheta(theta);
+        std::vector<sf::Vector2f> approx(QUERY_COUNT);
+        const auto treeTime = time_ms([&] {
+            for (std::size_t i = 0; i < QUERY_COUNT; ++i)
+                approx[i] = tree.getField(queries[i]);
+        });
+
+        std::vector<double> relativeErrors(QUERY_COUNT);
+        double errorMax = 0.0;
+        for (std::size_t i = 0; i < QUERY_COUNT; ++i) {
+            const auto difference = static_cast<double>((approx[i] - exact[i].field).length());
+            relativeErrors[i] = difference / static_cast<double>(exact[i].field.length());
+            errorMax = std::max(errorMax, difference / static_cast<double>(exact[i].magnitudeSum));
+        }
+        std::nth_element(relativeErrors.begin(), relativeErrors.begin() + QUERY_COUNT / 2, relativeErrors.end());
+
+        spdlog::info("Theta {:.2f}   | {:8.3f} ms | {:6.2f}x | median relative error {:.4f}% | max error {:.4f}%",
+                     theta,
+                     treeTime,
+                     exactTime / treeTime,
+                     relativeErrors[QUERY_COUNT / 2] * 100.0,
+                     errorMax * 100.0);
+
+        if (theta == bb::BARNES_HUT_THETA && errorMax > MAX_ERROR) {
+            spdlog::error("Max error at the default theta is above {}%", MAX_ERROR * 100.0);
+            withinBounds = false;
+        }
+    }
+
+    // Baked from the tree at the default theta, its error includes the tree's
+    tree.setTheta(bb::BARNES_HUT_THETA);
+    std::vector<SpatialGrid::Circle> surfaces;
+    for (const auto& m : masses)
+        surfaces.push_back({ m.position, PLANET_RADIUS });
+
+    GravityField field;
+    const auto bakeTime = time_ms([&] {
+        field.bake({ 0.0f, 0.0f },
+                   { 20000.0f, 20000.0f },
+                   FIELD_CELL_SIZE,
+                   surfaces,
+                   FIELD_CELL_SIZE * 2.0f,
+                   [&tree](const sf::Vector2f& position) { return tree.getField(position); });
+    });
+    spdlog::info("Field bake   | {:8.3f} ms | {} nodes, cell size {}", bakeTime, field.getNodeCount(), FIELD_CELL_SIZE);
+
+    std::vector<std::optional<sf::Vector2f>> sampled(QUERY_COUNT);
+    const auto fieldTime = time_ms([&] {
+        for (std::size_t i = 0; i < QUERY_COUNT; ++i)
+            sampled[i] = field.sample(queries[i]);
+    });
+
+    std::size_t fallbacks = 0;
+    double errorMax = 0.0;
+    for (std::size_t i = 0; i < QUERY_COUNT; ++i) {
+        if (!sampled[i]) {
+            ++fallbacks;
+            continue;
+        }
+        const auto difference = static_cast<double>((*sampled[i] - exact[i].field).length());
+        errorMax = std::max(errorMax, difference / static_cast<double>(exact[i].magnitudeSum));
+    }
+    spdlog::info("Field sample | {:8.3f} ms | {:6.2f}x | {} exact fallbacks | max error {:.4f}%",
+                 fieldTime,
+                 exactTime / fieldTime,
+                 fallbacks,
+                 errorMax * 100.0);
+
+    // A field far coarser than the planets, as --gravity-field allows, still
+    // has to fall back to the exact sum on every planet rather than
+    // interpolate across one
+    std::vector<SpatialGrid::Circle> smallSurfaces;
+    std::uniform_real_distribution<float> smallPositionDist(100.0f, 1900.0f);
+    for (std::size_t i = 0; i < SMALL_PLANET_COUNT; ++i)
+        smallSurfaces.push_back({ { smallPositionDist(engine), smallPositionDist(engine) }, SMALL_PLANET_RADIUS });
+    GravityField coarseField;
+    coarseField.bake({ 0.0f, 0.0f },
+                     { 2000.0f, 2000.0f },
+                     COARSE_CELL_SIZE,
+                     smallSurfaces,
+                     bb::GRAVITY_FIELD_EXACT_MARGIN,
+                     [](const sf::Vector2f&) { return sf::Vector2f { 1.0f, 0.0f }; });
+    std::uniform_real_distribution<float> offsetDist(-SMALL_PLANET_RADIUS, SMALL_PLANET_RADIUS);
+    std::size_t interpolated = 0;
+    for (const auto& s : smallSurfaces) {
+        for (std::size_t i = 0; i < 64; ++i) {
+            const sf::Vector2f offset { offsetDist(engine), offsetDist(engine) };
+            const auto isOnPlanet = offset.lengthSq() <= SMALL_PLANET_RADIUS * SMALL_PLANET_RADIUS;
+            if (isOnPlanet && coarseField.sample(s.position + offset))
+                ++interpolated;
+        }
+    }
+    spdlog::info("Coarse field | cell size {} | {} samples on planets interpolated", COARSE_CELL_SIZE, interpolated);
+    if (interpolated > 0) {
+        spdlog::error("The coarse field interpolated across a planet");
+        withinBounds = false;
+    }
+
+    return withinBounds ? 0 : 1;
+}
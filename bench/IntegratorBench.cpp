@@ -0,0 +1,145 @@
+// Compares the scalar and SIMD PhysicsWorld integrator kernels at different
+// body counts, and checks the SIMD results match the scalar path exactly,
+// exits non-zero on a mismatch.
+
+#include "PhysicsKernels.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+constexpr float TIME_STEP { 1.0f / 120.0f };
+constexpr std::size_t STEPS_PER_RUN { 200 };
+constexpr std::size_t RUNS { 5 };
+
+struct BodyStore {
+    explicit BodyStore(std::size_t count)
+        : positionX(count)
+        , positionY(count)
+        , rotation(count)
+        , velocityX(count)
+        , velocityY(count)
+        , angularVelocity(count)
+        , forceX(count)
+        , forceY(count)
+        , torque(count)
+        , invMass(count)
+        , invInertia(count)
+        , isActive(count)
+    {
+        std::default_random_engine engine(1234);
+        std::uniform_real_distribution<float> positionDist(0.0f, 800.0f);
+        std::uniform_real_distribution<float> velocityDist(-400.0f, 400.0f);
+        std::uniform_real_distribution<float> rotationDist(0.0f, 360.0f);
+        std::uniform_int_distribution<int> activeDist(0, 9);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            positionX[i] = positionDist(engine);
+            positionY[i] = positionDist(engine);
+            rotation[i] = rotationDist(engine);
+            velocityX[i] = velocityDist(engine);
+            velocityY[i] = velocityDist(engine);
+            angularVelocity[i] = velocityDist(engine) * 0.05f;
+            invMass[i] = 1.0f / 1.0e5f;
+            invInertia[i] = 1.0f / 1.0e3f;
+            // Roughly one in ten bodies are inactive to exercise the masking
+            isActive[i] = activeDist(engine) != 0 ? 1 : 0;
+        }
+    }
+
+    auto getArrays() -> BodyArrays
+    {
+        return { positionX.data(),
+                 positionY.data(),
+                 rotation.data(),
+                 velocityX.data(),
+                 velocityY.data(),
+                 angularVelocity.data(),
+                 forceX.data(),
+                 forceY.data(),
+                 torque.data(),
+                 invMass.data(),
+                 invInertia.data(),
+                 isActive.data(),
+                 positionX.size() };
+    }
+
+    void applyForces()
+    {
+        for (std::size_t i = 0; i < forceX.size(); ++i) {
+            forceX[i] = 2.0e7f;
+            forceY[i] = -1.0e7f;
+            torque[i] = 8.0e3f;
+        }
+    }
+
+    auto matches(const BodyStore& other) const -> bool
+    {
+        const auto same = [](const std::vector<float>& a, const std::vector<float>& b) {
+            return std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+        };
+        return same(positionX, other.positionX) && same(positionY, other.positionY) && same(rotation, other.rotation)
+            && same(velocityX, other.velocityX) && same(velocityY, other.velocityY)
+            && same(angularVelocity, other.angularVelocity);
+    }
+
+    std::vector<float> positionX, positionY, rotation;
+    std::vector<float> velocityX, velocityY, angularVelocity;
+    std::vector<float> forceX, forceY, torque;
+    std::vector<float> invMass, invInertia;
+    std::vector<std::uint8_t> isActive;
+};
+
+// Best nanoseconds per body step over several runs
+double time_kernel(IntegratorKernel kernel, BodyStore& store)
+{
+    auto best = std::numeric_limits<double>::max();
+    for (std::size_t run = 0; run < RUNS; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t step = 0; step < STEPS_PER_RUN; ++step) {
+            // Forces are cleared by every step, so half the steps run with
+            // thrust applied and half coast
+            if (step % 2 == 0)
+                store.applyForces();
+            integrate_bodies(kernel, store.getArrays(), TIME_STEP);
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        best = std::min(best, elapsed.count() / static_cast<double>(STEPS_PER_RUN * store.positionX.size()));
+    }
+    return best;
+}
+
+int main()
+{
+    const IntegratorKernel kernels[] = { IntegratorKernel::Scalar, IntegratorKernel::SSE41, IntegratorKernel::AVX2 };
+
+    bool isMatching = true;
+    spdlog::info("Best supported kernel: {}", get_integrator_kernel_name(detect_integrator_kernel()));
+    for (const std::size_t bodyCount : { 1000u, 10000u, 100000u }) {
+        BodyStore reference(bodyCount);
+        const auto scalarTime = time_kernel(IntegratorKernel::Scalar, reference);
+        spdlog::info("{:>7} bodies | {:<7} | {:7.3f} ns/body", bodyCount, "Scalar", scalarTime);
+
+        for (const auto kernel : kernels) {
+            if (kernel == IntegratorKernel::Scalar || !is_integrator_kernel_supported(kernel))
+                continue;
+
+            BodyStore store(bodyCount);
+            const auto time = time_kernel(kernel, store);
+            const bool matches = store.matches(reference);
+            isMatching &= matches;
+            spdlog::info("{:>7} bodies | {:<7} | {:7.3f} ns/body | {:5.2f}x | matches scalar: {}",
+                         bodyCount,
+                         get_integrator_kernel_name(kernel),
+                         time,
+                         scalarTime / time,
+                         matches ? "yes" : "NO");
+        }
+    }
+
+    return isMatching ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+// Times a particle frame (advance, then write every quad) with the scalar
+// and SIMD particle kernels at different particle counts, against the
+// per particle float colour lerp the particle effects used before. SIMD
+// results are checked against the scalar path, exits non-zero on a mismatch.
+
+#include "ParticleKernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+constexpr float FRAME_TIME { 1.0f / 60.0f };
+constexpr float LIFETIME { 10.0f }; // Long enough that nothing dies mid run
+constexpr std::size_t FRAMES_PER_RUN { 50 };
+constexpr std::size_t RUNS { 5 };
+
+constexpr ParticleLook BENCH_LOOK { { 4.0f, 4.0f }, { 255, 255, 255, 255 }, { 66, 135, 245, 50 } };
+
+struct ParticleStore {
+    explicit ParticleStore(std::size_t count)
+        : positionX(count)
+        , positionY(count)
+        , velocityX(count)
+        , velocityY(count)
+        , age(count)
+        , vertices(count * 6)
+    {
+        std::default_random_engine engine(1234);
+        std::uniform_real_distribution<float> positionDist(0.0f, 800.0f);
+        std::uniform_real_distribution<float> velocityDist(-250.0f, 250.0f);
+        std::uniform_real_distribution<float> ageDist(0.0f, LIFETIME / 2.0f);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            positionX[i] = positionDist(engine);
+            positionY[i] = positionDist(engine);
+            velocityX[i] = velocityDist(engine);
+            velocityY[i] = velocityDist(engine);
+            age[i] = ageDist(engine);
+        }
+    }
+
+    auto getArrays() -> ParticleArrays
+    {
+        return { positionX.data(), positionY.data(), velocityX.data(), velocityY.data(), age.data(), age.size() };
+    }
+
+    auto matches(const ParticleStore& other) const -> bool
+    {
+        for (std::size_t i = 0; i < vertices.size(); ++i) {
+            const auto& a = vertices[i];
+            const auto& b = other.vertices[i];
+            if (a.position != b.position || a.color != b.color)
+                return false;
+        }
+        return positionX == other.positionX && positionY == other.positionY && age == other.age;
+    }
+
+    std::vector<float> positionX, positionY;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> age;
+    std::vector<sf::Vertex> vertices;
+};
+
+// The per particle path the effects used before the kernels, a float lerp
+// with a divide per channel and the quad corners from a per effect switch
+auto reference_lerp_colour(const sf::Color& start, const sf::Color& end, float t) -> sf::Color
+{
+    const auto lerp = [t](std::uint8_t from, std::uint8_t to) {
+        const auto value = (1 - t) * (from / 255.0f) + t * (to / 255.0f);
+        return static_cast<std::uint8_t>(value * 255.0f);
+    };
+    return { lerp(start.r, end.r), lerp(start.g, end.g), lerp(start.b, end.b), lerp(start.a, end.a) };
+}
+
+void reference_frame(ParticleStore& store, int effectType)
+{
+    for (std::size_t i = 0; i < store.age.size(); ++i) {
+        store.age[i] += FRAME_TIME;
+        store.positionX[i] += store.velocityX[i] * FRAME_TIME;
+        store.positionY[i] += store.velocityY[i] * FRAME_TIME;
+
+        const auto t = std::clamp(store.age[i] / LIFETIME, 0.0f, 1.0f);
+        sf::Vector2f halfSize;
+        sf::Color colour;
+        switch (effectType) {
+        case 0:
+            halfSize = BENCH_LOOK.size / 2.0f;
+            colour = reference_lerp_colour(BENCH_LOOK.colourStart, BENCH_LOOK.colourEnd, t);
+            break;
+        default:
+            halfSize = { 8.0f, 8.0f };
+            colour = reference_lerp_colour({ 252, 119, 3, 255 }, { 50, 50, 50, 50 }, t);
+            break;
+        }
+
+        const sf::Vector2f position { store.positionX[i], store.positionY[i] };
+        const std::array<sf::Vector2f, 4> corners { position - halfSize,
+                                                    position + sf::Vector2f { halfSize.x, -halfSize.y },
+                                                    position + halfSize,
+                                                    position + sf::Vector2f { -halfSize.x, halfSize.y } };
+        sf::Vertex* v = &store.vertices[i * 6];
+        v[0].position = corners[0];
+        v[1].position = corners[1];
+        v[2].position = corners[2];
+        v[3].position = corners[2];
+        v[4].position = corners[3];
+        v[5].position = corners[0];
+        for (std::size_t j = 0; j < 6; ++j)
+            v[j].color = colour;
+    }
+}
+
+void kernel_frame(ParticleKernel kernel, ParticleStore& store)
+{
+    const auto particles = store.getArrays();
+    advance_particles(kernel, particles, FRAME_TIME);
+    write_particle_quads<BENCH_LOOK>(kernel, particles, 0, particles.count, 1.0f / LIFETIME, store.vertices.data());
+}
+
+// Best nanoseconds per particle frame over several runs
+template <typename Frame>
+double time_frames(std::size_t particleCount, Frame&& frame)
+{
+    auto best = std::numeric_limits<double>::max();
+    for (std::size_t run = 0; run < RUNS; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < FRAMES_PER_RUN; ++i)
+            frame();
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        best = std::min(best, elapsed.count() / static_cast<double>(FRAMES_PER_RUN * particleCount));
+    }
+    return best;
+}
+
+int main()
+{
+    const ParticleKernel kernels[] = { ParticleKernel::Scalar, ParticleKernel::SSE41, ParticleKernel::AVX2 };
+
+    bool isMatching = true;
+    spdlog::info("Best supported kernel: {}", get_integrator_kernel_name(detect_integrator_kernel()));
+    for (const std::size_t particleCount : { 10000u, 100000u }) {
+        ParticleStore referenceStore(particleCount);
+        // The switch is on a runtime value like the old per effect dispatch
+        volatile int effectType = 0;
+        const auto referenceTime = time_frames(particleCount, [&] { reference_frame(referenceStore, effectType); });
+        spdlog::info("{:>7} particles | {:<9} | {:7.3f} ns/particle", particleCount, "Reference", referenceTime);
+
+        // Scalar runs first, every other kernel is compared against it
+        std::optional<ParticleStore> scalarStore;
+        for (const auto kernel : kernels) {
+            if (!is_integrator_kernel_supported(kernel))
+                continue;
+
+            ParticleStore store(particleCount);
+            const auto time = time_frames(particleCount, [&] { kernel_frame(kernel, store); });
+            const bool matches = !scalarStore || store.matches(*scalarStore);
+            isMatching &= matches;
+            spdlog::info("{:>7} particles | {:<9} | {:7.3f} ns/particle | {:5.2f}x | matches scalar: {}",
+                         particleCount,
+                         get_integrator_kernel_name(kernel),
+                         time,
+                         referenceTime / time,
+                         matches ? "yes" : "NO");
+            if (!scalarStore)
+                scalarStore = std::move(store);
+        }
+    }
+
+    return isMatching ? 0 : 1;
+}
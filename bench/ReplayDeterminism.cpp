@@ -0,0 +1,170 @@
+// Records a scripted run of the first level with its particle effects, saves
+// & reloads the recording, then replays it with the same particle seed on a
+// thread pool of a different size. Exits non-zero unless the replay's
+// trajectory & particles match the recorded run's exactly. Recordings don't
+// hold the seed, the particles are driven by this test's fixed ticks rather
+// than the game's frames.
+
+#include "ParticleSystem.hpp"
+#include "Simulation.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <system_error>
+
+constexpr std::uint64_t TICK_COUNT { 120 * 30 };
+constexpr std::uint64_t TICKS_PER_ATTEMPT { 600 }; // The run is reset this often to stay near the planets
+constexpr std::uint32_t PARTICLE_SEED { 0x5eed };
+
+struct RunResult {
+    std::uint64_t ticks { 0 };
+    std::uint64_t trajectoryHash { 0 };
+    std::uint64_t particleHash { 14695981039346656037ull };
+};
+
+// Thrusts & turns in a pattern that varies every second
+auto get_input(std::uint64_t tick) -> InputState
+{
+    const auto segment = tick / 120;
+    InputState input;
+    input.linear_thrust = segment % 3 == 2 ? 0.0f : 1.0f;
+    input.angular_thrust = static_cast<float>(segment % 5) * 0.5f - 1.0f;
+    return input;
+}
+
+// Drives the effects from a tick the way PlayState does, then hashes every
+// live particle's quad
+void play_particles(ParticleSystem& particles,
+                    const Simulation& sim,
+                    const InputState& input,
+                    const RocketController::Events& events,
+                    RunResult& result)
+{
+    particles.update(sim.timeStep);
+
+    const auto collisionInfo = sim.rocket.getCollisionInfo();
+    if (events.collidedWithPlanet && collisionInfo)
+        particles.burst(ParticleSystem::Type::Planet_Collision, collisionInfo->point, collisionInfo->normal);
+    if (events.objectivesCollected > 0)
+        particles.burst(ParticleSystem::Type::Objective_Collected, sim.rocket.getPosition(), {});
+    if (input.linear_thrust != 0.0f) {
+        const auto thrust = input.linear_thrust > 0.0f ? 1.0f : -1.0f;
+        particles.setEmitter(ParticleSystem::Type::Rocket_Exhaust,
+                             sim.rocket.getPosition(),
+                             sf::Vector2f { 1.0f, sim.rocket.getRotation() } * -thrust);
+        particles.start(ParticleSystem::Type::Rocket_Exhaust);
+    } else {
+        particles.stop(ParticleSystem::Type::Rocket_Exhaust);
+    }
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(ParticleSystem::Type::MAX_TYPE); ++i) {
+        const auto type = static_cast<ParticleSystem::Type>(i);
+        const auto* vertices = particles.getVertices(type);
+        for (std::size_t v = 0; v < particles.getParticleCount(type) * 6; ++v) {
+            std::uint8_t bytes[sizeof(sf::Vector2f) + sizeof(sf::Color)];
+            std::memcpy(bytes, &vertices[v].position, sizeof(sf::Vector2f));
+            std::memcpy(bytes + sizeof(sf::Vector2f), &vertices[v].color, sizeof(sf::Color));
+            for (const auto byte : bytes) {
+                result.particleHash ^= byte;
+                result.particleHash *= 1099511628211ull;
+            }
+        }
+    }
+}
+
+auto record(InputRecording& recording, ThreadPool& pool) -> RunResult
+{
+    Simulation sim;
+    ParticleSystem particles(pool, PARTICLE_SEED, { nullptr, { { 0, 0 }, { 64, 64 } } });
+    RunResult result;
+
+    sim.level.loadLevel(GameLevel::Levels::One);
+    sim.rocket.reset();
+    recording.recordLevelLoad(GameLevel::Levels::One);
+    recording.recordTimeStep(sim.timeStep);
+
+    for (std::uint64_t tick = 0; tick < TICK_COUNT; ++tick) {
+        const auto input = get_input(tick);
+        recording.recordTick(input);
+        const auto events = sim.tick(input);
+        play_particles(particles, sim, input, events, result);
+
+        if (events.collidedWithPlanet || (tick + 1) % TICKS_PER_ATTEMPT == 0) {
+            sim.reset();
+            recording.recordReset();
+        }
+    }
+
+    result.ticks = sim.stats.ticks;
+    result.trajectoryHash = sim.stats.trajectoryHash;
+    return result;
+}
+
+auto replay(const InputRecording& recording, ThreadPool& pool, std::uint32_t particleSeed) -> RunResult
+{
+    Simulation sim;
+    ParticleSystem particles(pool, particleSeed, { nullptr, { { 0, 0 }, { 64, 64 } } });
+    RunResult result;
+
+    run_replay(sim, recording, [&](const InputState& input, const RocketController::Events& events) {
+        play_particles(particles, sim, input, events, result);
+    });
+
+    result.ticks = sim.stats.ticks;
+    result.trajectoryHash = sim.stats.trajectoryHash;
+    return result;
+}
+
+int main()
+{
+    const auto path = std::filesystem::temp_directory_path() / "impossible-rocket-replay-test.irr";
+    try {
+        ThreadPool recordPool(1);
+        InputRecording recording;
+        const auto recorded = record(recording, recordPool);
+        recording.saveToFile(path);
+
+        InputRecording loaded;
+        loaded.loadFromFile(path);
+        std::filesystem::remove(path);
+
+        ThreadPool replayPool(3);
+        const auto replayed = replay(loaded, replayPool, PARTICLE_SEED);
+        // Another seed has to change the particles, or the hash isn't seeing them
+        const auto reseeded = replay(loaded, replayPool, PARTICLE_SEED + 1);
+
+        spdlog::info("Recorded {} ticks, trajectory {:016x}, particles {:016x}",
+                     recorded.ticks,
+                     recorded.trajectoryHash,
+                     recorded.particleHash);
+        spdlog::info("Replayed {} ticks, trajectory {:016x}, particles {:016x}",
+                     replayed.ticks,
+                     replayed.trajectoryHash,
+                     replayed.particleHash);
+
+        if (replayed.ticks != recorded.ticks || replayed.trajectoryHash != recorded.trajectoryHash) {
+            spdlog::error("The replay's trajectory doesn't match the recorded run");
+            return 1;
+        }
+        if (replayed.particleHash != recorded.particleHash) {
+            spdlog::error("The replay's particles don't match the recorded run");
+            return 1;
+        }
+        if (reseeded.particleHash == recorded.particleHash) {
+            spdlog::error("Changing the particle seed didn't change the particles");
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    spdlog::info("Replay matches the recorded run");
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Runs random input schedules through PhysicsWorld & RocketController the way
+// the game's fixed steps do, predicting each one first with
+// TrajectoryPredictor::predictOne from the same starting state. Exits
+// non-zero unless every prediction matches the real run bit for bit: the
+// position after each tick, the first planet & objective hits and the final
+// state, for every integrator kernel the CPU supports. Runs that would hit a
+// planet during their warm up start just after the step into it.
+
+#include "GameLevel.hpp"
+#include "GameplayBlackboard.hpp"
+#include "PhysicsWorld.hpp"
+#include "RocketController.hpp"
+#include "ThreadPool.hpp"
+#include "TrajectoryPredictor.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+constexpr std::uint32_t SCHEDULE_COUNT { 1000 };
+constexpr std::uint32_t MAX_WARM_UP_TICKS { 1200 };
+constexpr std::uint32_t PREDICTED_TICKS { 600 };
+
+struct RunResult {
+    std::vector<sf::Vector2f> points;
+    std::optional<std::uint32_t> planetHitTick;
+    std::optional<GameLevel::PlanetCollisionInfo> planetHit;
+    std::optional<std::uint32_t> objectiveHitTick;
+    BodyState finalState;
+};
+
+template <typename T>
+auto bit_equal(const T& a, const T& b) -> bool
+{
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T>
+auto bit_equal(const std::vector<T>& a, const std::vector<T>& b) -> bool
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+// Held for a random number of ticks each, with full, partial & no thrust
+auto random_inputs(std::mt19937& engine, std::uint32_t tickCount) -> std::vector<InputState>
+{
+    std::uniform_int_distribution<std::uint32_t> holdDist(1, 90);
+    std::uniform_int_distribution<int> kindDist(0, 3);
+    std::uniform_real_distribution<float> thrustDist(-1.0f, 1.0f);
+    const auto pick = [&] {
+        const auto kind = kindDist(engine);
+        return kind == 0 ? 0.0f : kind == 1 ? 1.0f : kind == 2 ? -1.0f : thrustDist(engine);
+    };
+
+    std::vector<InputState> inputs;
+    while (inputs.size() < tickCount) {
+        const InputState input { pick(), pick() };
+        inputs.insert(inputs.end(), holdDist(engine), input);
+    }
+    inputs.resize(tickCount);
+    return inputs;
+}
+
+// Runs the rules then a step per input, like PlayState's tick callback, from
+// a state just after a step
+auto run_controller(PhysicsWorld& world,
+                    RocketController& rocket,
+                    const std::vector<InputState>& inputs,
+                    const sf::Time& timeStep) -> RunResult
+{
+    RunResult result;
+    result.points.push_back(rocket.getPosition());
+    for (std::uint32_t tick = 0; tick < inputs.size(); ++tick) {
+        const auto events = rocket.update(inputs[tick]);
+        if (events.objectivesCollected > 0 && !result.objectiveHitTick)
+            result.objectiveHitTick = tick;
+        if (events.collidedWithPlanet) {
+            result.planetHitTick = tick;
+            result.planetHit = rocket.getCollisionInfo();
+            break;
+        }
+        world.step(timeStep, timeStep);
+        result.points.push_back(rocket.getPosition());
+    }
+
+    if (!bit_equal(result.points.back(), rocket.getPosition()))
+        result.points.push_back(rocket.getPosition());
+    result.finalState = rocket.getBodyState();
+    return result;
+}
+
+auto to_result(const TrajectoryPredictor::Trajectory& trajectory) -> RunResult
+{
+    RunResult result;
+    result.points = trajectory.points;
+    if (trajectory.planetHit) {
+        result.planetHitTick = trajectory.planetHit->tick;
+        result.planetHit = trajectory.planetHit->info;
+    }
+    if (trajectory.objectiveHit)
+        result.objectiveHitTick = trajectory.objectiveHit->tick;
+    result.finalState = trajectory.finalState;
+    return result;
+}
+
+auto describe_mismatch(const RunResult& predicted, const RunResult& actual) -> const char*
+{
+    if (!bit_equal(predicted.points, actual.points))
+        return "path";
+    if (predicted.planetHitTick != actual.planetHitTick
+        || (predicted.planetHit && actual.planetHit && !bit_equal(*predicted.planetHit, *actual.planetHit)))
+        return "planet hit";
+    if (predicted.objectiveHitTick != actual.objectiveHitTick)
+        return "objective hit";
+    if (!bit_equal(predicted.finalState, actual.finalState))
+        return "final state";
+    return nullptr;
+}
+
+struct Game {
+    explicit Game(IntegratorKernel kernel, GameLevel::Levels levelId)
+    {
+        world.setIntegratorKernel(kernel);
+        level.loadLevel(levelId);
+        rocket.reset();
+    }
+
+    PhysicsWorld world;
+    GameLevel level;
+    RocketController rocket { world, level };
+};
+
+// Runs the rules then a step per input, stopping before the rules that would
+// find a planet hit. A second game run from the same start with the probe's
+// tick count ends on the step into the planet, where the sweep matters.
+auto warm_up(IntegratorKernel kernel,
+             GameLevel::Levels levelId,
+             const std::vector<InputState>& inputs,
+             const sf::Time& timeStep) -> std::unique_ptr<Game>
+{
+    auto tickCount = inputs.size();
+    {
+        Game probe(kernel, levelId);
+        for (std::size_t tick = 0; tick < inputs.size(); ++tick) {
+            if (probe.rocket.update(inputs[tick]).collidedWithPlanet) {
+                tickCount = tick;
+                break;
+            }
+            probe.world.step(timeStep, timeStep);
+        }
+    }
+
+    auto game = std::make_unique<Game>(kernel, levelId);
+    for (std::size_t tick = 0; tick < tickCount; ++tick) {
+        game->rocket.update(inputs[tick]);
+        game->world.step(timeStep, timeStep);
+    }
+    return game;
+}
+
+int main()
+{
+    try {
+        const auto timeStep = bb::FIXED_TIME_STEP;
+        TrajectoryPredictor::Settings settings;
+        settings.tickCount = PREDICTED_TICKS;
+        settings.sampleInterval = 1;
+        settings.timeStep = timeStep;
+        ThreadPool pool(1);
+
+        std::uint32_t mismatches = 0;
+        std::uint32_t planetHits = 0;
+        std::uint32_t immediateHits = 0;
+        std::uint32_t objectiveHits = 0;
+        for (const auto kernel : { IntegratorKernel::Scalar, IntegratorKernel::SSE41, IntegratorKernel::AVX2 }) {
+            if (!is_integrator_kernel_supported(kernel))
+                continue;
+
+            std::mt19937 engine(1234);
+            std::uniform_int_distribution<std::uint32_t> warmUpDist(1, MAX_WARM_UP_TICKS);
+            for (std::uint32_t schedule = 0; schedule < SCHEDULE_COUNT; ++schedule) {
+                const auto levelCount = static_cast<std::uint32_t>(GameLevel::Levels::MAX_LEVEL) - 1;
+                const auto levelId = static_cast<GameLevel::Levels>(1 + schedule % levelCount);
+                const auto game = warm_up(kernel, levelId, random_inputs(engine, warmUpDist(engine)), timeStep);
+                const TrajectoryPredictor predictor(game->level, pool);
+
+                TrajectoryPredictor::Request request;
+                request.state = game->rocket.getBodyState();
+                request.sweepStart = game->rocket.getSweepStart();
+                request.inputs = random_inputs(engine, PREDICTED_TICKS);
+
+                // Predicted first, the real run collects objectives
+                const auto predicted = to_result(predictor.predictOne(request, settings));
+                const auto actual = run_controller(game->world, game->rocket, request.inputs, timeStep);
+                planetHits += actual.planetHitTick ? 1u : 0u;
+                immediateHits += actual.planetHitTick == 0u ? 1u : 0u;
+                objectiveHits += actual.objectiveHitTick ? 1u : 0u;
+                if (const auto* mismatch = describe_mismatch(predicted, actual)) {
+                    spdlog::error("{} kernel, schedule {}: the predicted {} doesn't match the real run",
+                                  get_integrator_kernel_name(kernel),
+                                  schedule,
+                                  mismatch);
+                    ++mismatches;
+                }
+            }
+        }
+
+        spdlog::info("{} planet hits, {} on the first tick, & {} objective hits",
+                     planetHits,
+                     immediateHits,
+                     objectiveHits);
+        if (mismatches > 0) {
+            spdlog::error("{} predictions didn't match gameplay", mismatches);
+            return 1;
+        }
+        // The comparison is only worth anything if the runs hit things
+        if (immediateHits == 0 || planetHits == immediateHits || objectiveHits == 0) {
+            spdlog::error("The runs didn't hit planets on & after the first tick & objectives");
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    spdlog::info("Every prediction matches gameplay bit for bit");
+    return 0;
+}
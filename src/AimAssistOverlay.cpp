@@ -0,0 +1,79 @@
+#include "AimAssistOverlay.hpp"
+#include "GameplayBlackboard.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Turning inputs held for the whole prediction, one path each
+constexpr std::array<float, 5> ANGULAR_INPUTS { -1.0f, -0.5f, 0.0f, 0.5f, 1.0f };
+constexpr auto MARKER_SIZE { 6.0f };
+
+AimAssistOverlay::AimAssistOverlay(const GameLevel& level, ThreadPool& pool)
+    : m_gameLevel(level)
+    , m_predictor(level, pool)
+    , m_requests(ANGULAR_INPUTS.size())
+    , m_lines(sf::PrimitiveType::Lines)
+{
+    for (auto& request : m_requests)
+        request.inputs.resize(bb::AIM_ASSIST_TICKS);
+}
+
+void AimAssistOverlay::update(const BodyState& rocketState,
+                              const sf::Vector2f& sweepStart,
+                              const InputState& input,
+                              const sf::Time& timeStep)
+{
+    for (std::size_t i = 0; i < m_requests.size(); ++i) {
+        m_requests[i].state = rocketState;
+        m_requests[i].sweepStart = sweepStart;
+        std::fill(m_requests[i].inputs.begin(),
+                  m_requests[i].inputs.end(),
+                  InputState { input.linear_thrust, ANGULAR_INPUTS[i] });
+    }
+
+    TrajectoryPredictor::Settings settings;
+    settings.tickCount = bb::AIM_ASSIST_TICKS;
+    settings.sampleInterval = bb::AIM_ASSIST_SAMPLE_INTERVAL;
+    settings.timeStep = timeStep;
+    m_predictor.predict(m_requests, settings, m_trajectories);
+
+    // Paths & markers share one array so the overlay is a single draw call,
+    // markers go last to sit on top of every path
+    m_lines.clear();
+    for (std::size_t i = 0; i < m_trajectories.size(); ++i) {
+        const auto& trajectory = m_trajectories[i];
+        // The path the player is currently steering along stands out
+        const bool isCurrent = std::abs(ANGULAR_INPUTS[i] - input.angular_thrust) < 0.25f;
+        const sf::Color colour { 255, 255, 255, static_cast<std::uint8_t>(isCurrent ? 200 : 60) };
+
+        for (std::size_t p = 1; p < trajectory.points.size(); ++p) {
+            m_lines.append({ trajectory.points[p - 1], colour });
+            m_lines.append({ trajectory.points[p], colour });
+        }
+    }
+
+    for (const auto& trajectory : m_trajectories) {
+        if (trajectory.planetHit)
+            addMarker(trajectory.planetHit->info.point, sf::Color::Red);
+        if (trajectory.objectiveHit)
+            addMarker(m_gameLevel.getObjectives()[trajectory.objectiveHit->objective].position, sf::Color::Green);
+    }
+}
+
+void AimAssistOverlay::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
+    target.draw(m_lines, states);
+}
+
+auto AimAssistOverlay::getVertexCount() const -> std::size_t { return m_lines.getVertexCount(); }
+
+void AimAssistOverlay::addMarker(const sf::Vector2f& position, const sf::Color& colour)
+{
+    // A small cross
+    m_lines.append({ position + sf::Vector2f { -MARKER_SIZE, -MARKER_SIZE }, colour });
+    m_lines.append({ position + sf::Vector2f { MARKER_SIZE, MARKER_SIZE }, colour });
+    m_lines.append({ position + sf::Vector2f { -MARKER_SIZE, MARKER_SIZE }, colour });
+    m_lines.append({ position + sf::Vector2f { MARKER_SIZE, -MARKER_SIZE }, colour });
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include "GameLevel.hpp"
+#include "InputState.hpp"
+#include "TrajectoryPredictor.hpp"
+
+#include <vector>
+
+// Draws the predicted paths for the current thrust combined with a spread of
+// turning inputs, marking where each would hit a planet or objective
+class AimAssistOverlay : public sf::Drawable {
+public:
+    AimAssistOverlay(const GameLevel& level, ThreadPool& pool);
+
+    void update(const BodyState& rocketState,
+                const sf::Vector2f& sweepStart,
+                const InputState& input,
+                const sf::Time& timeStep);
+
+    auto getVertexCount() const -> std::size_t;
+
+protected:
+    virtual void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
+
+private:
+    void addMarker(const sf::Vector2f& position, const sf::Color& colour);
+
+    const GameLevel& m_gameLevel;
+    TrajectoryPredictor m_predictor;
+    std::vector<TrajectoryPredictor::Request> m_requests;
+    std::vector<TrajectoryPredictor::Trajectory> m_trajectories;
+    sf::VertexArray m_lines;
+};
@@ -1,16 +1,21 @@
 #include "App.hpp"
 #include "AssetHolder.hpp"
+#include "FrameArena.hpp"
 #include "InputHandler.hpp"
 #include "MenuState.hpp"
 #include "PlayState.hpp"
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
 
 #include <imgui-SFML.h>
 #include <imgui.h>
-#include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <vector>
 
 constexpr auto WINDOW_TITLE { "Impossible Rocket - [indev]" };
+constexpr std::size_t PROFILER_CAPTURE_FRAMES { 300 };
+constexpr auto PROFILER_TRACE_PATH { "profile_trace.json" };
 
 App::App()
 {
@@ -30,6 +35,9 @@ App::App()
     // Sigleton creation;
     InputHandler::get();
     AssetHolder::get();
+    ThreadPool::get();
+    FrameArena::get();
+    Profiler::get();
 
     m_states.push(std::make_unique<PlayState>(m_window));
     m_states.push(std::make_unique<MenuState>(m_window));
@@ -48,6 +56,9 @@ App::~App()
 
     delete (&InputHandler::get());
     delete (&AssetHolder::get());
+    delete (&ThreadPool::get());
+    delete (&FrameArena::get());
+    delete (&Profiler::get());
 }
 
 void App::run()
@@ -57,6 +68,10 @@ void App::run()
     m_states.top()->enter();
 
     while (m_window.isOpen()) {
+        // Nothing from the last frame's arena allocations survives the frame
+        FrameArena::get().reset();
+        AssetHolder::get().uploadPendingTextures();
+
         auto deltaTime = loopClock.restart();
         if (deltaTime > sf::seconds(0.25f)) {
             deltaTime = sf::seconds(0.25f);
@@ -66,6 +81,9 @@ void App::run()
 
         InputHandler::get().handleEvents(m_window);
         ImGui::SFML::Update(m_window, deltaTime);
+#if defined(IMPOSSIBLE_ROCKET_PROFILE)
+        drawProfiler();
+#endif
 
         if (m_states.top()->isStateCompleted()) {
             m_states.pop();
@@ -73,12 +91,23 @@ void App::run()
             m_states.top()->enter();
         }
 
-        m_states.top()->update(deltaTime);
+        {
+            PROFILE_ZONE("Update");
+            m_states.top()->update(deltaTime);
+        }
+
+        {
+            PROFILE_ZONE("Draw");
+            m_window.clear();
+            m_states.top()->draw();
+            ImGui::SFML::Render(m_window);
+        }
 
-        m_window.clear();
-        m_states.top()->draw();
-        ImGui::SFML::Render(m_window);
-        m_window.display();
+        {
+            PROFILE_ZONE("Display");
+            m_window.display();
+        }
+        PROFILE_END_FRAME();
     }
 }
 
@@ -92,9 +121,59 @@ void App::logFPS(const sf::Time& dt)
         ++counter;
     } else {
         auto fps = 1.0f / (sum.asSeconds() / static_cast<float>(counter));
-        const auto newTitle = fmt::format("{} - FPS {}", WINDOW_TITLE, static_cast<std::uint32_t>(fps));
-        m_window.setTitle(newTitle);
+        const auto newTitle = frame_format("{} - FPS {}", WINDOW_TITLE, static_cast<std::uint32_t>(fps));
+        m_window.setTitle(newTitle.c_str());
         sum = sf::Time::Zero;
         counter = 0;
     }
-}
\ No newline at end of file
+}
+#if defined(IMPOSSIBLE_ROCKET_PROFILE)
+void App::drawProfiler()
+{
+    // Stats are only gathered while the panel is showing
+    auto& profiler = Profiler::get();
+    if (!ImGui::Begin("Profiler")) {
+        ImGui::End();
+        return;
+    }
+    if (profiler.isCapturing()) {
+        ImGui::Text("Capturing...");
+    } else if (ImGui::Button("Capture Trace")) {
+        profiler.startCapture(PROFILER_CAPTURE_FRAMES, PROFILER_TRACE_PATH);
+    }
+
+    profiler.getZoneStats(m_zoneStats);
+    const auto& zones = m_zoneStats;
+    // Zone times in milliseconds over the last few hundred samples
+    if (ImGui::BeginTable("Zones", 4)) {
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Min");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableSetupColumn("P99");
+        ImGui::TableHeadersRow();
+        for (const auto& zone : zones) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(zone.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", static_cast<double>(zone.minMs));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", static_cast<double>(zone.avgMs));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", static_cast<double>(zone.p99Ms));
+        }
+        ImGui::EndTable();
+    }
+
+    for (const auto& zone : zones) {
+        ImGui::PlotLines(zone.name.c_str(),
+                         zone.samplesMs.data(),
+                         static_cast<int>(zone.samplesMs.size()),
+                         0,
+                         nullptr,
+                         0.0f,
+                         zone.p99Ms * 1.5f);
+    }
+    ImGui::End();
+}
+#endif
@@ -3,9 +3,11 @@
 #include <SFML/Graphics.hpp>
 
 #include "BaseState.hpp"
+#include "Profiler.hpp"
 
 #include <memory>
 #include <stack>
+#include <vector>
 
 class App {
 public:
@@ -16,7 +18,13 @@ public:
 
 private:
     void logFPS(const sf::Time& dt);
+#if defined(IMPOSSIBLE_ROCKET_PROFILE)
+    void drawProfiler();
+#endif
 
     sf::RenderWindow m_window;
     std::stack<std::unique_ptr<BaseState>> m_states;
+#if defined(IMPOSSIBLE_ROCKET_PROFILE)
+    std::vector<Profiler::ZoneStats> m_zoneStats; // Kept between frames so the panel doesn't allocate
+#endif
 };
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ThreadPool.hpp"
+
+#include <array>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Path keyed assets loaded on the thread pool. Each asset loads once however
+// many threads ask for it, and the cache is split into shards with a lock
+// each so requests for different assets rarely wait on one another. Assets
+// live as long as the cache, a failed load rethrows from every get.
+template <typename T>
+class AssetCache {
+public:
+    // Fills in the default constructed asset, throws on failure
+    using LoadFunc = std::function<void(T& asset)>;
+
+    AssetCache() = default;
+    ~AssetCache() { waitAll(); }
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // Queues the load the first time path is requested
+    auto load(const std::string& path, ThreadPool& pool, LoadFunc loadFunc) -> std::shared_future<T*>;
+    // Loads still running reference the cache, it has to outlive them
+    void waitAll();
+
+private:
+    static constexpr std::size_t SHARD_COUNT { 8 };
+
+    struct Entry {
+        std::unique_ptr<T> asset;
+        std::shared_future<T*> loaded;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    std::array<Shard, SHARD_COUNT> m_shards;
+};
+
+template <typename T>
+auto AssetCache<T>::load(const std::string& path, ThreadPool& pool, LoadFunc loadFunc) -> std::shared_future<T*>
+{
+    auto& shard = m_shards[std::hash<std::string>()(path) % SHARD_COUNT];
+    std::lock_guard lock(shard.mutex);
+    auto [entry, isNew] = shard.entries.try_emplace(path);
+    if (isNew) {
+        entry->second.asset = std::make_unique<T>();
+        auto* asset = entry->second.asset.get();
+        entry->second.loaded = pool.submit([asset, loadFunc = std::move(loadFunc)] {
+                                       loadFunc(*asset);
+                                       return asset;
+                                   }).share();
+    }
+    return entry->second.loaded;
+}
+
+template <typename T>
+void AssetCache<T>::waitAll()
+{
+    for (auto& shard : m_shards) {
+        std::lock_guard lock(shard.mutex);
+        for (auto& [path, entry] : shard.entries)
+            entry.loaded.wait();
+    }
+}
@@ -1,69 +1,221 @@
 #include "AssetHolder.hpp"
+#include "SpriteAtlas.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+constexpr auto ASSET_PACK_PATH { "bin/assets.pack" };
+
+// Index into sprite_atlas::REGIONS of each AssetId, -1 for assets outside the atlas
+constexpr auto ATLAS_REGION_INDICES = [] {
+    std::array<int, ASSET_COUNT> indices {};
+    for (std::size_t i = 0; i < ASSET_COUNT; ++i) {
+        indices[i] = -1;
+        for (std::size_t j = 0; j < sprite_atlas::REGIONS.size(); ++j) {
+            if (sprite_atlas::REGIONS[j].path == ASSET_PATHS[i])
+                indices[i] = static_cast<int>(j);
+        }
+    }
+    return indices;
+}();
 
-sf::Font* AssetHolder::getFont(const std::filesystem::path& path)
+auto to_rect(const sprite_atlas::Region& region) -> sf::IntRect
 {
-    const auto pathString = path.string();
-    const auto result = m_fontMap.find(pathString);
+    return { { region.left, region.top }, { region.width, region.height } };
+}
+
+auto to_path(AssetId id) -> std::filesystem::path { return std::filesystem::path(get_asset_path(id)); }
+}
 
-    if (result != m_fontMap.end()) {
-        return &(*result).second;
+AssetHolder::AssetHolder()
+{
+    try {
+        if (!m_pack.open(ASSET_PACK_PATH))
+            spdlog::warn("No asset pack at {}, loading loose files", ASSET_PACK_PATH);
+    } catch (const std::exception& e) {
+        spdlog::error("{}, loading loose files", e.what());
     }
+}
 
-    if (!std::filesystem::exists(path))
-        throw std::runtime_error(fmt::format("Font at path {} not found", pathString));
+auto AssetHolder::loadFont(AssetId id) -> std::shared_future<sf::Font*>
+{
+    return loadById(m_fontIds, id, [this](const auto& path) { return loadFont(path); });
+}
 
-    if (!m_fontMap[pathString].loadFromFile(path))
-        throw std::runtime_error(fmt::format("Unable to load font {}", pathString));
+auto AssetHolder::loadTexture(AssetId id) -> std::shared_future<sf::Texture*>
+{
+    return loadById(m_textureIds, id, [this](const auto& path) { return loadTexture(path); });
+}
 
-    return &m_fontMap[pathString];
+auto AssetHolder::loadSoundBuffer(AssetId id) -> std::shared_future<sf::SoundBuffer*>
+{
+    return loadById(m_soundBufferIds, id, [this](const auto& path) { return loadSoundBuffer(path); });
 }
 
-sf::Texture* AssetHolder::getTexture(const std::filesystem::path& path)
+auto AssetHolder::loadMusic(AssetId id) -> std::shared_future<sf::Music*>
+{
+    return loadById(m_musicIds, id, [this](const auto& path) { return loadMusic(path); });
+}
+
+sf::Font* AssetHolder::getFont(AssetId id) { return loadFont(id).get(); }
+
+sf::Texture* AssetHolder::getTexture(AssetId id)
 {
-    const auto pathString = path.string();
-    const auto result = m_textureMap.find(pathString);
-    if (result != m_textureMap.end())
-        return &(*result).second;
+    // Not yet uploaded, the path version uploads it now
+    const auto loaded = loadTexture(id);
+    if (loaded.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        return loaded.get();
+    return getTexture(to_path(id));
+}
 
-    if (!std::filesystem::exists(path))
-        throw std::runtime_error(fmt::format("Texture at path {} not found", pathString));
+sf::SoundBuffer* AssetHolder::getSoundBuffer(AssetId id) { return loadSoundBuffer(id).get(); }
 
-    if (!m_textureMap[pathString].loadFromFile(path))
-        throw std::runtime_error(fmt::format("Unable to load texture {}", pathString));
+sf::Music* AssetHolder::getMusic(AssetId id) { return loadMusic(id).get(); }
 
-    return &m_textureMap[pathString];
+auto AssetHolder::loadFont(const std::filesystem::path& path) -> std::shared_future<sf::Font*>
+{
+    return m_fonts.load(path.string(), m_loaderPool, [this, path](sf::Font& font) {
+        const auto packed = m_pack.find(path.generic_string());
+        if (!(packed ? font.loadFromMemory(packed->data, packed->size) : font.loadFromFile(path)))
+            throw std::runtime_error(fmt::format("Unable to load font {}", path.string()));
+    });
+}
+
+auto AssetHolder::loadTexture(const std::filesystem::path& path) -> std::shared_future<sf::Texture*>
+{
+    std::lock_guard lock(m_textureMutex);
+    return findOrLoadTexture(path).loaded;
+}
+
+auto AssetHolder::loadSoundBuffer(const std::filesystem::path& path) -> std::shared_future<sf::SoundBuffer*>
+{
+    return m_soundBuffers.load(path.string(), m_loaderPool, [this, path](sf::SoundBuffer& soundBuffer) {
+        const auto packed = m_pack.find(path.generic_string());
+        if (!(packed ? soundBuffer.loadFromMemory(packed->data, packed->size) : soundBuffer.loadFromFile(path)))
+            throw std::runtime_error(fmt::format("Unable to load sound {}", path.string()));
+    });
+}
+
+auto AssetHolder::loadMusic(const std::filesystem::path& path) -> std::shared_future<sf::Music*>
+{
+    return m_music.load(path.string(), m_loaderPool, [this, path](sf::Music& music) {
+        // Music streams from the pack, which outlives it
+        const auto packed = m_pack.find(path.generic_string());
+        if (!(packed ? music.openFromMemory(packed->data, packed->size) : music.openFromFile(path)))
+            throw std::runtime_error(fmt::format("Unable to load music {}", path.string()));
+    });
+}
+
+sf::Font* AssetHolder::getFont(const std::filesystem::path& path) { return loadFont(path).get(); }
+
+sf::Texture* AssetHolder::getTexture(const std::filesystem::path& path)
+{
+    std::lock_guard lock(m_textureMutex);
+    auto& entry = findOrLoadTexture(path);
+    if (!entry.isUploaded) {
+        entry.image.wait();
+        upload(entry);
+        // Every entry is pending until it's uploaded, checked all the same
+        // as erasing end() would be undefined
+        const auto pending = std::find(m_pendingTextures.begin(), m_pendingTextures.end(), &entry);
+        if (pending != m_pendingTextures.end())
+            m_pendingTextures.erase(pending);
+    }
+    return entry.loaded.get();
 }
 
 sf::SoundBuffer* AssetHolder::getSoundBuffer(const std::filesystem::path& path)
 {
-    const auto pathString = path.string();
-    const auto result = m_soundBufferMap.find(pathString);
-    if (result != m_soundBufferMap.end())
-        return &(*result).second;
+    return loadSoundBuffer(path).get();
+}
+
+sf::Music* AssetHolder::getMusic(const std::filesystem::path& path) { return loadMusic(path).get(); }
 
-    if (!std::filesystem::exists(path))
-        throw std::runtime_error(fmt::format("Sound at path {} not found", pathString));
+void AssetHolder::uploadPendingTextures()
+{
+    std::lock_guard lock(m_textureMutex);
+    // One check per entry, a decode finishing between an upload pass & a
+    // removal pass would drop the entry without uploading it
+    auto kept = m_pendingTextures.begin();
+    for (auto* entry : m_pendingTextures) {
+        if (entry->image.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            upload(*entry);
+        else
+            *kept++ = entry;
+    }
+    m_pendingTextures.erase(kept, m_pendingTextures.end());
+}
 
-    if (!m_soundBufferMap[pathString].loadFromFile(path))
-        throw std::runtime_error(fmt::format("Unable to load sound {}", pathString));
+AssetHolder::AtlasRegion AssetHolder::getAtlasRegion(AssetId id)
+{
+    const auto index = ATLAS_REGION_INDICES[static_cast<std::size_t>(id)];
+    if (index < 0)
+        throw std::runtime_error(fmt::format("Texture {} is not in the sprite atlas", get_asset_path(id)));
 
-    return &m_soundBufferMap[pathString];
+    loadAtlas();
+    return { &m_atlasTexture, to_rect(sprite_atlas::REGIONS[static_cast<std::size_t>(index)]) };
 }
 
-sf::Music* AssetHolder::getMusic(const std::filesystem::path& path)
+AssetHolder::AtlasRegion AssetHolder::getAtlasRegion(const std::filesystem::path& path)
 {
-    const auto pathString = path.string();
-    const auto result = m_musicMap.find(pathString);
-    if (result != m_musicMap.end())
-        return &(*result).second;
+    const auto* region = sprite_atlas::find_region(path.generic_string());
+    if (!region)
+        throw std::runtime_error(fmt::format("Texture {} is not in the sprite atlas", path.string()));
 
-    if (!std::filesystem::exists(path))
-        throw std::runtime_error(fmt::format("Music at path {} not found", pathString));
+    loadAtlas();
+    return { &m_atlasTexture, to_rect(*region) };
+}
+
+auto AssetHolder::findOrLoadTexture(const std::filesystem::path& path) -> TextureEntry&
+{
+    auto& entry = m_textureMap[path.string()];
+    if (!entry) {
+        entry = std::make_unique<TextureEntry>();
+        entry->loaded = entry->uploaded.get_future().share();
+        entry->image = m_images.load(path.string(), m_loaderPool, [this, path](sf::Image& image) {
+            const auto packed = m_pack.find(path.generic_string());
+            if (!(packed ? image.loadFromMemory(packed->data, packed->size) : image.loadFromFile(path)))
+                throw std::runtime_error(fmt::format("Unable to load texture {}", path.string()));
+        });
+        m_pendingTextures.push_back(entry.get());
+    }
+    return *entry;
+}
+
+void AssetHolder::upload(TextureEntry& entry)
+{
+    // Decode errors are passed on through the texture's future
+    try {
+        if (!entry.texture.loadFromImage(*entry.image.get()))
+            throw std::runtime_error("Unable to upload texture");
+        entry.uploaded.set_value(&entry.texture);
+    } catch (...) {
+        entry.uploaded.set_exception(std::current_exception());
+    }
+    entry.isUploaded = true;
+}
 
-    if (!m_musicMap[pathString].openFromFile(path))
-        throw std::runtime_error(fmt::format("Unable to load music {}", pathString));
+template <typename T, typename LoadPath>
+auto AssetHolder::loadById(IdSlots<T>& slots, AssetId id, LoadPath loadPath) -> std::shared_future<T*>
+{
+    const auto index = static_cast<std::size_t>(id);
+    std::call_once(slots.once[index], [&] { slots.loaded[index] = loadPath(to_path(id)); });
+    return slots.loaded[index];
+}
 
-    return &m_musicMap[pathString];
+void AssetHolder::loadAtlas()
+{
+    if (m_isAtlasLoaded)
+        return;
+
+    if (!m_atlasTexture.create({ sprite_atlas::WIDTH, sprite_atlas::HEIGHT }))
+        throw std::runtime_error("Unable to create the sprite atlas texture");
+    m_atlasTexture.update(sprite_atlas::PIXELS);
+    if (!m_atlasTexture.generateMipmap())
+        throw std::runtime_error("Unable to generate mip maps");
+    m_isAtlasLoaded = true;
 }
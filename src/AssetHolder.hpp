@@ -1,13 +1,36 @@
 #pragma once
 
+#include "AssetCache.hpp"
+#include "AssetIds.hpp"
+#include "AssetPack.hpp"
+#include "ThreadPool.hpp"
+
 #include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <array>
 #include <filesystem>
-#include <optional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
+// Fonts, sounds & music are loaded on the holder's own loader threads and the
+// load functions can be called from any thread. Textures are decoded there
+// too, but uploaded on the main thread by uploadPendingTextures, or straight
+// away by getTexture. The get functions are the blocking versions of the loads,
+// requesting several assets before getting any lets them load in parallel.
+//
+// Assets are read from bin/assets.pack when it has them, see AssetPack, and
+// from their own files otherwise.
+//
+// Assets under bin/ have an AssetId generated at build time, see
+// tools/AssetIdGenerator.cpp. Once an id has been requested its lookups are
+// array indexed, no path is built or hashed. The path functions are the slow
+// path for tools & assets without an id.
 class AssetHolder {
 public:
     static AssetHolder& get()
@@ -16,15 +39,83 @@ public:
         return instance;
     }
 
+    auto loadFont(AssetId id) -> std::shared_future<sf::Font*>;
+    auto loadTexture(AssetId id) -> std::shared_future<sf::Texture*>;
+    auto loadSoundBuffer(AssetId id) -> std::shared_future<sf::SoundBuffer*>;
+    auto loadMusic(AssetId id) -> std::shared_future<sf::Music*>;
+
+    sf::Font* getFont(AssetId id);
+    // Main thread only
+    sf::Texture* getTexture(AssetId id);
+    sf::SoundBuffer* getSoundBuffer(AssetId id);
+    sf::Music* getMusic(AssetId id);
+
+    auto loadFont(const std::filesystem::path& path) -> std::shared_future<sf::Font*>;
+    auto loadTexture(const std::filesystem::path& path) -> std::shared_future<sf::Texture*>;
+    auto loadSoundBuffer(const std::filesystem::path& path) -> std::shared_future<sf::SoundBuffer*>;
+    auto loadMusic(const std::filesystem::path& path) -> std::shared_future<sf::Music*>;
+
     sf::Font* getFont(const std::filesystem::path& path);
+    // Main thread only
     sf::Texture* getTexture(const std::filesystem::path& path);
     sf::SoundBuffer* getSoundBuffer(const std::filesystem::path& path);
     sf::Music* getMusic(const std::filesystem::path& path);
 
+    // Uploads every texture that has finished decoding, call once a frame on the main thread
+    void uploadPendingTextures();
+
+    struct AtlasRegion {
+        sf::Texture* texture { nullptr };
+        sf::IntRect rect;
+    };
+    // The image's place in the sprite atlas packed at build time, see
+    // tools/AtlasPacker.cpp. The atlas is uploaded on first use, main
+    // thread only.
+    AtlasRegion getAtlasRegion(AssetId id);
+    AtlasRegion getAtlasRegion(const std::filesystem::path& path);
+
 private:
-    AssetHolder() = default;
-    std::unordered_map<std::string, sf::Font> m_fontMap;
-    std::unordered_map<std::string, sf::Texture> m_textureMap;
-    std::unordered_map<std::string, sf::SoundBuffer> m_soundBufferMap;
-    std::unordered_map<std::string, sf::Music> m_musicMap;
+    static constexpr std::size_t LOADER_THREAD_COUNT { 2 };
+
+    // Filled in the first time each id is requested
+    template <typename T>
+    struct IdSlots {
+        std::array<std::once_flag, ASSET_COUNT> once;
+        std::array<std::shared_future<T*>, ASSET_COUNT> loaded;
+    };
+
+    struct TextureEntry {
+        std::shared_future<sf::Image*> image;
+        sf::Texture texture;
+        std::promise<sf::Texture*> uploaded;
+        std::shared_future<sf::Texture*> loaded;
+        bool isUploaded { false };
+    };
+
+    AssetHolder();
+    auto findOrLoadTexture(const std::filesystem::path& path) -> TextureEntry&;
+    void upload(TextureEntry& entry);
+    template <typename T, typename LoadPath>
+    auto loadById(IdSlots<T>& slots, AssetId id, LoadPath loadPath) -> std::shared_future<T*>;
+    void loadAtlas();
+
+    // First so it's unmapped after the fonts & music reading from it
+    AssetPack m_pack;
+    sf::Texture m_atlasTexture;
+    bool m_isAtlasLoaded { false };
+    AssetCache<sf::Font> m_fonts;
+    AssetCache<sf::Image> m_images;
+    AssetCache<sf::SoundBuffer> m_soundBuffers;
+    AssetCache<sf::Music> m_music;
+    std::mutex m_textureMutex;
+    std::unordered_map<std::string, std::unique_ptr<TextureEntry>> m_textureMap;
+    std::vector<TextureEntry*> m_pendingTextures; // Decoding or decoded, not yet uploaded
+    IdSlots<sf::Font> m_fontIds;
+    IdSlots<sf::Texture> m_textureIds;
+    IdSlots<sf::SoundBuffer> m_soundBufferIds;
+    IdSlots<sf::Music> m_musicIds;
+    // Kept off ThreadPool::get(), a slow decode there would hold a worker the
+    // frame's parallelFors could be using. Last so it's joined before
+    // anything its loads write to is destroyed.
+    ThreadPool m_loaderPool { LOADER_THREAD_COUNT };
 };
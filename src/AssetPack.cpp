@@ -0,0 +1,211 @@
+#include "AssetPack.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <lz4.h>
+#include <lz4hc.h>
+#include <spdlog/fmt/fmt.h>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+constexpr std::uint32_t ASSET_PACK_MAGIC { 0x4b505249 }; // "IRPK"
+constexpr std::uint32_t ASSET_PACK_VERSION { 1 };
+// Blobs start on this boundary from the start of the file, which the
+// mapping puts on a page boundary
+constexpr std::uint64_t BLOB_ALIGNMENT { 16 };
+
+enum class Compression : std::uint16_t {
+    None,
+    LZ4
+};
+
+// Packs are native endian: this header, an entry for each asset sorted by
+// path, the paths' characters, then each asset's blob
+struct PackHeader {
+    std::uint32_t magic { 0 };
+    std::uint32_t version { 0 };
+    std::uint32_t entryCount { 0 };
+    std::uint32_t pathBytes { 0 };
+};
+
+struct PackEntry {
+    std::uint64_t offset { 0 }; // From the start of the file
+    std::uint32_t storedSize { 0 };
+    std::uint32_t size { 0 }; // Once decompressed
+    std::uint32_t pathOffset { 0 }; // From the start of the paths
+    std::uint16_t pathLength { 0 };
+    Compression compression { Compression::None };
+};
+
+static_assert(std::is_trivially_copyable_v<PackEntry> && sizeof(PackEntry) == 24,
+              "Pack entries are written & read as raw bytes");
+
+auto read_file(const std::string& path) -> std::vector<char>
+{
+    std::ifstream file(path, std::ios::binary);
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to open {}", path));
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+}
+
+auto AssetPack::open(const std::filesystem::path& path) -> bool
+{
+    m_entries.clear();
+    m_decompressed.clear();
+    if (!m_file.open(path))
+        return false;
+
+    // Copied out rather than cast, like compiled levels
+    const auto* data = m_file.getData();
+    const auto fileSize = m_file.getSize();
+    PackHeader header;
+    if (fileSize >= sizeof(header))
+        std::memcpy(&header, data, sizeof(header));
+    const auto pathsStart = sizeof(header) + std::uint64_t { header.entryCount } * sizeof(PackEntry);
+    if (fileSize < sizeof(header) || header.magic != ASSET_PACK_MAGIC || header.version != ASSET_PACK_VERSION
+        || fileSize < pathsStart + header.pathBytes) {
+        m_file.close();
+        throw std::runtime_error(fmt::format("Asset pack {} is corrupt", path.string()));
+    }
+
+    const auto* paths = reinterpret_cast<const char*>(data + pathsStart);
+    m_entries.reserve(header.entryCount);
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        PackEntry packed;
+        std::memcpy(&packed, data + sizeof(header) + i * sizeof(PackEntry), sizeof(packed));
+        // Uncompressed blobs are handed out at their decompressed size, so it
+        // has to be the size that's in the file. The blob's end isn't summed,
+        // an offset near the top of the range would wrap past the check.
+        const auto isUnknownCompression = packed.compression != Compression::None
+            && packed.compression != Compression::LZ4;
+        if (std::uint64_t { packed.pathOffset } + packed.pathLength > header.pathBytes || packed.offset > fileSize
+            || packed.storedSize > fileSize - packed.offset || isUnknownCompression
+            || (packed.compression == Compression::None && packed.size != packed.storedSize)) {
+            m_entries.clear();
+            m_file.close();
+            throw std::runtime_error(fmt::format("Asset pack {} is corrupt", path.string()));
+        }
+
+        Entry entry;
+        entry.path = { paths + packed.pathOffset, packed.pathLength };
+        entry.offset = packed.offset;
+        entry.storedSize = packed.storedSize;
+        entry.size = packed.size;
+        entry.isCompressed = packed.compression == Compression::LZ4;
+        m_entries.push_back(entry);
+    }
+
+    // Found by binary search
+    const auto byPath = [](const Entry& a, const Entry& b) { return a.path < b.path; };
+    if (!std::is_sorted(m_entries.begin(), m_entries.end(), byPath)) {
+        m_entries.clear();
+        m_file.close();
+        throw std::runtime_error(fmt::format("Asset pack {} isn't sorted", path.string()));
+    }
+    return true;
+}
+
+auto AssetPack::isOpen() const -> bool { return m_file.getData() != nullptr; }
+
+auto AssetPack::find(std::string_view assetPath) -> std::optional<Blob>
+{
+    const auto entry = std::lower_bound(m_entries.begin(),
+                                        m_entries.end(),
+                                        assetPath,
+                                        [](const Entry& e, std::string_view p) { return e.path < p; });
+    if (entry == m_entries.end() || entry->path != assetPath)
+        return {};
+
+    const auto* stored = m_file.getData() + entry->offset;
+    if (!entry->isCompressed)
+        return Blob { stored, entry->size };
+
+    std::lock_guard lock(m_decompressedMutex);
+    auto [decompressed, isNew] = m_decompressed.try_emplace(&*entry);
+    if (isNew) {
+        decompressed->second.resize(entry->size);
+        const auto size = LZ4_decompress_safe(reinterpret_cast<const char*>(stored),
+                                              reinterpret_cast<char*>(decompressed->second.data()),
+                                              static_cast<int>(entry->storedSize),
+                                              static_cast<int>(entry->size));
+        if (size < 0 || static_cast<std::uint32_t>(size) != entry->size) {
+            m_decompressed.erase(decompressed);
+            throw std::runtime_error(fmt::format("Unable to decompress {} from the asset pack", assetPath));
+        }
+    }
+    return Blob { decompressed->second.data(), decompressed->second.size() };
+}
+
+void AssetPack::write(const std::filesystem::path& packPath, std::vector<std::string> assetPaths)
+{
+    std::sort(assetPaths.begin(), assetPaths.end());
+    assetPaths.erase(std::unique(assetPaths.begin(), assetPaths.end()), assetPaths.end());
+
+    PackHeader header;
+    header.magic = ASSET_PACK_MAGIC;
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = static_cast<std::uint32_t>(assetPaths.size());
+    std::vector<PackEntry> entries(assetPaths.size());
+    std::vector<std::vector<char>> blobs;
+    std::string paths;
+    for (std::size_t i = 0; i < assetPaths.size(); ++i) {
+        const auto& assetPath = assetPaths[i];
+        auto& entry = entries[i];
+        auto blob = read_file(assetPath);
+        if (assetPath.size() > std::numeric_limits<std::uint16_t>::max()
+            || blob.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE))
+            throw std::runtime_error(fmt::format("{} is too big to pack", assetPath));
+        entry.pathOffset = static_cast<std::uint32_t>(paths.size());
+        entry.pathLength = static_cast<std::uint16_t>(assetPath.size());
+        entry.size = static_cast<std::uint32_t>(blob.size());
+        paths += assetPath;
+
+        // Most formats are compressed already, only keep the LZ4 block when
+        // it saves at least an eighth
+        if (!blob.empty()) {
+            const auto blobSize = static_cast<int>(blob.size());
+            std::vector<char> compressed(static_cast<std::size_t>(LZ4_compressBound(blobSize)));
+            const auto compressedSize = LZ4_compress_HC(
+                blob.data(), compressed.data(), blobSize, static_cast<int>(compressed.size()), LZ4HC_CLEVEL_MAX);
+            if (compressedSize > 0 && static_cast<std::size_t>(compressedSize) <= blob.size() - blob.size() / 8) {
+                compressed.resize(static_cast<std::size_t>(compressedSize));
+                blob = std::move(compressed);
+                entry.compression = Compression::LZ4;
+            }
+        }
+        entry.storedSize = static_cast<std::uint32_t>(blob.size());
+        blobs.push_back(std::move(blob));
+    }
+    header.pathBytes = static_cast<std::uint32_t>(paths.size());
+
+    const auto align = [](std::uint64_t position) {
+        return (position + BLOB_ALIGNMENT - 1) / BLOB_ALIGNMENT * BLOB_ALIGNMENT;
+    };
+    auto offset = align(sizeof(header) + entries.size() * sizeof(PackEntry) + paths.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        entries[i].offset = offset;
+        offset = align(offset + entries[i].storedSize);
+    }
+
+    std::ofstream file(packPath, std::ios::binary | std::ios::trunc);
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to write {}", packPath.string()));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()),
+               static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+    file.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        // Padded up to the blob's offset
+        const auto position = static_cast<std::uint64_t>(file.tellp());
+        const std::vector<char> padding(entries[i].offset - position, '\0');
+        file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        file.write(blobs[i].data(), static_cast<std::streamsize>(blobs[i].size()));
+    }
+    if (!file.good())
+        throw std::runtime_error(fmt::format("Unable to write {}", packPath.string()));
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Every asset in one file, mapped once so loading an asset doesn't open or
+// stat its own file. Assets are looked up by their path as they were packed,
+// see tools/AssetPackBuilder.cpp. Entries the build found worth compressing
+// are LZ4 blocks, decompressed on their first find & kept until the pack is
+// closed.
+class AssetPack {
+public:
+    struct Blob {
+        const std::uint8_t* data { nullptr };
+        std::size_t size { 0 };
+    };
+
+    AssetPack() = default;
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // Returns false if there's no pack to map, throws if the pack is corrupt
+    auto open(const std::filesystem::path& path) -> bool;
+    auto isOpen() const -> bool;
+    // The asset's bytes, valid while the pack is open. Can be called from any thread.
+    auto find(std::string_view assetPath) -> std::optional<Blob>;
+
+    // Packs the files, each stored under its path as given
+    static void write(const std::filesystem::path& packPath, std::vector<std::string> assetPaths);
+
+private:
+    struct Entry {
+        std::string_view path;
+        std::uint64_t offset { 0 };
+        std::uint32_t storedSize { 0 };
+        std::uint32_t size { 0 };
+        bool isCompressed { false };
+    };
+
+    MappedFile m_file;
+    std::vector<Entry> m_entries; // Sorted by path
+    std::mutex m_decompressedMutex;
+    std::unordered_map<const Entry*, std::vector<std::uint8_t>> m_decompressed;
+};
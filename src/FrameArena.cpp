@@ -0,0 +1,56 @@
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <spdlog/spdlog.h>
+
+FrameArena::FrameArena(std::size_t capacity)
+    : m_buffer(std::make_unique<std::byte[]>(capacity))
+    , m_capacity(capacity)
+{
+}
+
+void FrameArena::reset()
+{
+    m_lastFrameUsage = m_used + m_overflow;
+
+    // Grown here rather than mid frame, nothing in the old buffer is alive
+    if (m_overflow > 0) {
+        m_capacity = std::max(m_capacity * 2, m_lastFrameUsage);
+        m_buffer = std::make_unique<std::byte[]>(m_capacity);
+        spdlog::debug("Frame arena grown to {} bytes", m_capacity);
+    }
+
+    m_used = 0;
+    m_overflow = 0;
+}
+
+auto FrameArena::getResource() -> std::pmr::memory_resource* { return this; }
+
+auto FrameArena::getCapacity() const -> std::size_t { return m_capacity; }
+
+auto FrameArena::getLastFrameUsage() const -> std::size_t { return m_lastFrameUsage; }
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void* memory = m_buffer.get() + m_used;
+    auto space = m_capacity - m_used;
+    if (std::align(alignment, bytes, memory, space)) {
+        m_used = m_capacity - space + bytes;
+        return memory;
+    }
+
+    m_overflow += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void* memory, std::size_t bytes, std::size_t alignment)
+{
+    // Arena memory comes back on reset, only overflow goes back to the heap
+    const auto* address = static_cast<const std::byte*>(memory);
+    const std::less<const std::byte*> isBefore;
+    if (isBefore(address, m_buffer.get()) || !isBefore(address, m_buffer.get() + m_capacity))
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <spdlog/fmt/fmt.h>
+#include <string>
+#include <utility>
+
+// Bump allocator for data that only lives until the end of the frame, reset
+// at the top of App::run's loop. Hand getResource() to std::pmr containers,
+// allocating is a pointer bump & freeing does nothing, everything comes back
+// at once on reset. A frame that needs more than the arena holds gets the
+// rest from the heap & the arena grows at the next reset, so steady state
+// frames stay off the global heap. Main thread only.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static FrameArena& get()
+    {
+        static FrameArena& instance = *new FrameArena();
+        return instance;
+    }
+
+    explicit FrameArena(std::size_t capacity = 64 * 1024);
+
+    // Everything allocated since the last reset must be dead by now
+    void reset();
+
+    auto getResource() -> std::pmr::memory_resource*;
+    auto getCapacity() const -> std::size_t;
+    // Bytes the last frame allocated, heap overflow included
+    auto getLastFrameUsage() const -> std::size_t;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::unique_ptr<std::byte[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_used { 0 };
+    std::size_t m_overflow { 0 }; // Bytes that went to the heap this frame
+    std::size_t m_lastFrameUsage { 0 };
+};
+
+// fmt::format into a string from the frame arena, for text that's only
+// needed until the frame ends, like a string handed to sf::Text::setString
+template <typename... Args>
+auto frame_format(fmt::format_string<Args...> format, Args&&... args) -> std::pmr::string
+{
+    std::pmr::string result(FrameArena::get().getResource());
+    fmt::format_to(std::back_inserter(result), format, std::forward<Args>(args)...);
+    return result;
+}
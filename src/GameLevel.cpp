@@ -1,137 +1,174 @@
 #include "GameLevel.hpp"
-#include "AssetHolder.hpp"
 #include "GameplayBlackboard.hpp"
+#include "MappedFile.hpp"
+#include "Profiler.hpp"
 
-#include <SFML/Graphics/RenderTarget.hpp>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <type_traits>
 
-std::optional<GameLevel::PlanetCollisionInfo>
-circle_vs_circle(const sf::Vector2f& position_a, float radius_a, const sf::Vector2f& position_b, float radius_b)
+constexpr std::uint32_t COMPILED_LEVEL_MAGIC { 0x564c5249 }; // "IRLV"
+constexpr std::uint32_t COMPILED_LEVEL_VERSION { 1 };
+constexpr auto COMPILED_LEVEL_EXTENSION { ".lvl" };
+
+// Compiled levels are native endian: this header, the planets exactly as
+// GameLevel::Planet stores them, then each objective's position
+struct CompiledLevelHeader {
+    std::uint32_t magic { 0 };
+    std::uint32_t version { 0 };
+    float playerStartX { 0.0f };
+    float playerStartY { 0.0f };
+    std::uint32_t planetCount { 0 };
+    std::uint32_t objectiveCount { 0 };
+};
+
+static_assert(std::is_trivially_copyable_v<GameLevel::Planet> && sizeof(GameLevel::Planet) == sizeof(float) * 4,
+              "Compiled levels copy planets straight into GameLevel::Planet");
+
+// Earliest point where a circle moving from start to end touches another
+// circle, as a fraction of the move. Zero when they already overlap at the
+// start, so a move of zero length is the plain overlap test.
+std::optional<float> swept_circle_vs_circle(const sf::Vector2f& start,
+                                            const sf::Vector2f& end,
+                                            float radius_a,
+                                            const sf::Vector2f& position_b,
+                                            float radius_b)
 {
-    const float radii_sum_sq = std::pow((radius_a + radius_b), 2.0f);
-    sf::Vector2f difference = position_a - position_b;
-    const float length_squared = difference.lengthSq();
+    const auto move = end - start;
+    const auto offset = start - position_b;
+    const float radii_sum = radius_a + radius_b;
+
+    // |offset + move * t| = radii_sum, solved for the smaller t
+    const float c = offset.lengthSq() - radii_sum * radii_sum;
+    if (c <= 0.0f)
+        return 0.0f;
 
-    if (length_squared > radii_sum_sq)
+    const float b = offset.dot(move);
+    if (b >= 0.0f)
+        return {}; // Moving apart, or not at all
+
+    const float a = move.lengthSq();
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f)
         return {};
 
-    const auto normal = (position_a - position_b).normalized();
-    const auto point = position_b + (radius_b * normal);
-    return { { normal, point } };
+    const float t = (-b - std::sqrt(discriminant)) / a;
+    if (t > 1.0f)
+        return {};
+    return t;
 }
 
-GameLevel::GameLevel()
+// Grid query circle that covers the whole move
+SpatialGrid::Circle swept_bounds(const sf::Vector2f& start, const sf::Vector2f& end, float radius)
 {
-    auto sbCollect { AssetHolder::get().getSoundBuffer("bin/sounds/objective_collect.wav") };
-    m_collectObjective.setBuffer(*sbCollect);
+    return { (start + end) * 0.5f, radius + (end - start).length() * 0.5f };
 }
 
-void GameLevel::loadLevel(Levels level)
+GameLevel::GameLevel() { m_gravityTree.setTheta(bb::BARNES_HUT_THETA); }
+
+auto GameLevel::getLevelPath(Levels level) -> std::filesystem::path
 {
-    std::string levelPath;
     switch (level) {
     case GameLevel::Levels::Developer:
-        levelPath = "bin/levels/dev_level.txt";
-        break;
+        return "bin/levels/dev_level.txt";
     case GameLevel::Levels::One:
-        levelPath = "bin/levels/level_1.txt";
-        break;
+        return "bin/levels/level_1.txt";
     case GameLevel::Levels::Two:
-        levelPath = "bin/levels/level_2.txt";
-        break;
+        return "bin/levels/level_2.txt";
     case GameLevel::Levels::Three:
-        levelPath = "bin/levels/level_3.txt";
-        break;
+        return "bin/levels/level_3.txt";
     case GameLevel::Levels::Four:
-        levelPath = "bin/levels/level_4.txt";
-        break;
+        return "bin/levels/level_4.txt";
     case GameLevel::Levels::Five:
-        levelPath = "bin/levels/level_5.txt";
-        break;
+        return "bin/levels/level_5.txt";
     case GameLevel::Levels::Six:
-        levelPath = "bin/levels/level_6.txt";
-        break;
+        return "bin/levels/level_6.txt";
     default:
         assert(false);
         break;
     }
+    return {};
+}
 
-    std::ifstream levelFile(levelPath, std::ios::in);
-    if (levelFile.fail()) {
-        throw std::runtime_error(fmt::format("Unable to load {} level", levelPath));
-    }
-
+void GameLevel::loadLevel(Levels level)
+{
+    loadLevel(getLevelPath(level));
     m_currentLevel = level;
-    m_planets.clear();
-    m_objectives.clear();
-    auto objectiveTexture { AssetHolder::get().getTexture("bin/textures/objective_ring.png") };
-
-    while (!levelFile.eof()) {
-        std::string line;
-        levelFile >> line;
-        // Skip commented out lines
-        if (line == "#") {
-            line.resize(250);
-            levelFile.getline(line.data(), 250);
-            continue;
-        }
-
-        // Load start position
-        if (line[0] == 's') {
-            levelFile >> m_playerStart.x >> m_playerStart.y;
-        } else if (line[0] == 'p') // Load planets
-        {
-            m_planets.emplace_back();
-            float radius { 0.0f };
-            sf::Vector2f position;
-
-            levelFile >> radius >> position.x >> position.y >> m_planets.back().mass;
-            m_planets.back().shape.setSize({ radius * 2.f, radius * 2.f });
-            m_planets.back().shape.setOrigin({ radius, radius });
-            m_planets.back().shape.setPosition(position);
-            auto tex = AssetHolder::get().getTexture("bin/textures/planet.png");
-            if (!tex->generateMipmap())
-                throw std::runtime_error("Unable to generate mip maps");
-                
-            m_planets.back().shape.setTexture(tex);
-
-        } else if (line[0] == 'o') // Load objectives
-        {
-            sf::Vector2f pos;
-            levelFile >> pos.x >> pos.y;
+}
 
-            Objective o { sf::RectangleShape { bb::OBJECTIVE_SIZE }, true };
+void GameLevel::loadLevel(const std::filesystem::path& levelPath)
+{
+    if (levelPath.extension() == COMPILED_LEVEL_EXTENSION) {
+        if (!readCompiledLevel(levelPath))
+            throw std::runtime_error(fmt::format("Unable to load {} level", levelPath.string()));
+    } else {
+        // Stale compiled levels are skipped, the text is what was last edited
+        const auto compiledPath = getCompiledPath(levelPath);
+        std::error_code error;
+        const auto compiledTime = std::filesystem::last_write_time(compiledPath, error);
+        const bool hasCompiled = !error;
+        const auto textTime = std::filesystem::last_write_time(levelPath, error);
+        const bool isCompiledCurrent = hasCompiled && (error || compiledTime >= textTime);
 
-            o.shape.setOrigin(bb::OBJECTIVE_SIZE * 0.5f);
-            o.shape.setTexture(objectiveTexture);
-            o.shape.setPosition(pos);
-            m_objectives.push_back(o);
+        if (!isCompiledCurrent || !readCompiledLevel(compiledPath)) {
+            if (isCompiledCurrent)
+                spdlog::warn("Ignoring damaged compiled level {}", compiledPath.string());
+            parseLevelText(levelPath);
         }
     }
 
-    levelFile.close();
+    buildQueryStructures();
+    buildGravityField(levelPath);
     m_levelAttempts = 1;
 }
 
+auto GameLevel::getCompiledPath(const std::filesystem::path& levelPath) -> std::filesystem::path
+{
+    auto compiledPath = levelPath;
+    compiledPath.replace_extension(COMPILED_LEVEL_EXTENSION);
+    return compiledPath;
+}
+
+void GameLevel::compileLevel(const std::filesystem::path& textPath, const std::filesystem::path& compiledPath)
+{
+    GameLevel level;
+    level.parseLevelText(textPath);
+    if (!level.writeCompiledLevel(compiledPath))
+        throw std::runtime_error(fmt::format("Unable to write compiled level {}", compiledPath.string()));
+}
+
 void GameLevel::update(const sf::Time& dt)
 {
+    PROFILE_ZONE("GameLevel::update");
     for (auto& o : m_objectives) {
         if (!o.isActive)
             continue;
 
-        o.shape.rotate(dt.asSeconds() * sf::degrees(bb::OBJECTIVE_ROTATION_SPEED));
+        o.rotation = (o.rotation + dt.asSeconds() * sf::degrees(bb::OBJECTIVE_ROTATION_SPEED)).wrapUnsigned();
     }
 }
 
 sf::Vector2f GameLevel::getSummedForce(const sf::Vector2f& pos, float mass) const
 {
+    if (const auto acceleration = m_gravityField.sample(pos))
+        return *acceleration * mass;
+    return computeSummedForce(pos, mass);
+}
+
+auto GameLevel::computeSummedForce(const sf::Vector2f& pos, float mass) const -> sf::Vector2f
+{
+    if (m_useGravityTree)
+        return m_gravityTree.getField(pos) * (bb::BIG_G * mass);
+
     sf::Vector2f sum;
     for (auto& p : m_planets) {
-        const auto delta = p.shape.getPosition() - pos;
+        const auto delta = p.position - pos;
         const float radiusSq = delta.lengthSq();
         const float forceMag = bb::BIG_G * p.mass * mass / radiusSq;
 
@@ -140,39 +177,96 @@ sf::Vector2f GameLevel::getSummedForce(const sf::Vector2f& pos, float mass) cons
     return sum;
 }
 
-std::optional<GameLevel::PlanetCollisionInfo> GameLevel::doesCollideWithPlanet(const sf::Vector2f& pos,
-                                                                               float radius) const
+void GameLevel::setGravityTheta(float theta) { m_gravityTree.setTheta(theta); }
+
+void GameLevel::setGravityFieldEnabled(bool enabled) { m_isGravityFieldEnabled = enabled; }
+
+void GameLevel::setGravityFieldCellSize(float cellSize)
 {
-    for (auto& p : m_planets) {
-        const auto result
-            = circle_vs_circle(pos, radius, p.shape.getPosition(), p.shape.getGlobalBounds().width / 2.0f);
-        if (result)
-            return result;
-    }
-    return {};
+    assert(cellSize > 0.0f);
+    m_gravityFieldCellSize = cellSize;
 }
 
-void GameLevel::handleObjectiveIntersections(const sf::Vector2f& pos, float radius)
+void GameLevel::setGravityFieldCacheEnabled(bool enabled) { m_isGravityFieldCacheEnabled = enabled; }
+
+void GameLevel::copySettings(const GameLevel& other)
 {
-    for (auto& o : m_objectives) {
-        if (!o.isActive)
-            continue;
+    m_gravityTree.setTheta(other.m_gravityTree.getTheta());
+    m_gravityFieldCellSize = other.m_gravityFieldCellSize;
+    m_isGravityFieldEnabled = other.m_isGravityFieldEnabled;
+    m_isGravityFieldCacheEnabled = other.m_isGravityFieldCacheEnabled;
+}
+
+std::optional<GameLevel::PlanetCollisionInfo>
+GameLevel::doesCollideWithPlanet(const sf::Vector2f& start, const sf::Vector2f& end, float radius) const
+{
+    // Grid cells aren't visited in level order, keep the earliest hit and the
+    // lowest index between equally early ones so the result matches a linear scan
+    const auto bounds = swept_bounds(start, end, radius);
+    float hitTime = 2.0f;
+    std::size_t hitIndex = m_planets.size();
+    m_planetGrid.query(bounds.position, bounds.radius, [&](std::uint32_t index) {
+        const auto& p = m_planets[index];
+        const auto t = swept_circle_vs_circle(start, end, radius, p.position, p.radius);
+        if (t && (*t < hitTime || (*t == hitTime && index < hitIndex))) {
+            hitTime = *t;
+            hitIndex = index;
+        }
+        return false;
+    });
+
+    if (hitIndex == m_planets.size())
+        return {};
 
-        const auto result = circle_vs_circle(pos, radius, o.shape.getPosition(), bb::OBJECTIVE_SIZE.x / 2.0f);
-        if (result) {
-            if (m_collectObjective.getStatus() != sf::Sound::Status::Playing)
-                m_collectObjective.play();
+    const auto& p = m_planets[hitIndex];
+    PlanetCollisionInfo info;
+    info.position = start + (end - start) * hitTime;
+    info.normal = (info.position - p.position).normalized();
+    info.point = p.position + p.radius * info.normal;
+    return info;
+}
+
+auto GameLevel::handleObjectiveIntersections(const sf::Vector2f& start, const sf::Vector2f& end, float radius)
+    -> std::uint32_t
+{
+    const auto bounds = swept_bounds(start, end, radius);
+    std::uint32_t collected = 0;
+    m_objectiveGrid.query(bounds.position, bounds.radius, [&](std::uint32_t index) {
+        auto& o = m_objectives[index];
+        if (!o.isActive)
+            return false;
 
+        if (swept_circle_vs_circle(start, end, radius, o.position, bb::OBJECTIVE_SIZE.x / 2.0f)) {
             o.isActive = false;
+            ++collected;
         }
-    }
+        return false;
+    });
+    return collected;
+}
+
+auto GameLevel::findObjectiveIntersection(const sf::Vector2f& start, const sf::Vector2f& end, float radius) const
+    -> std::optional<std::size_t>
+{
+    const auto bounds = swept_bounds(start, end, radius);
+    std::optional<std::size_t> hit;
+    m_objectiveGrid.query(bounds.position, bounds.radius, [&](std::uint32_t index) {
+        const auto& o = m_objectives[index];
+        if (!o.isActive || (hit && *hit < index))
+            return false;
+
+        if (swept_circle_vs_circle(start, end, radius, o.position, bb::OBJECTIVE_SIZE.x / 2.0f))
+            hit = index;
+        return false;
+    });
+    return hit;
 }
 
 void GameLevel::resetLevel()
 {
     for (auto& o : m_objectives) {
         o.isActive = true;
-        o.shape.setRotation(sf::degrees(0.0f));
+        o.rotation = sf::degrees(0.0f);
     }
     ++m_levelAttempts;
 }
@@ -185,19 +279,182 @@ auto GameLevel::isLevelComplete() const -> bool
     return true;
 }
 
-auto GameLevel::getCurrentLevel() const -> Levels { return m_currentLevel; }
+void GameLevel::buildQueryStructures()
+{
+    std::vector<SpatialGrid::Circle> circles;
+    circles.reserve(m_planets.size());
+    for (const auto& p : m_planets)
+        circles.push_back({ p.position, p.radius });
+    m_planetGrid.build(circles);
 
-auto GameLevel::getAttemptTotal() const -> std::uint32_t { return m_levelAttempts; }
+    circles.clear();
+    for (const auto& o : m_objectives)
+        circles.push_back({ o.position, bb::OBJECTIVE_SIZE.x / 2.0f });
+    m_objectiveGrid.build(circles);
+
+    m_useGravityTree = m_planets.size() >= bb::BARNES_HUT_MIN_PLANETS;
+    m_gravityTree.clear();
+    if (m_useGravityTree) {
+        std::vector<GravityTree::Mass> masses;
+        masses.reserve(m_planets.size());
+        for (const auto& p : m_planets)
+            masses.push_back({ p.position, p.mass });
+        m_gravityTree.build(masses);
+    }
+}
 
-void GameLevel::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+void GameLevel::buildGravityField(const std::filesystem::path& levelPath)
 {
+    m_gravityField.clear();
+    if (!m_isGravityFieldEnabled || m_planets.empty())
+        return;
+
+    // Everything the baked values depend on goes in the cache key
+    std::uint64_t key { 14695981039346656037ull };
+    const auto hash = [&key](const void* data, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            key ^= static_cast<const std::uint8_t*>(data)[i];
+            key *= 1099511628211ull;
+        }
+    };
+    const auto theta = m_useGravityTree ? m_gravityTree.getTheta() : 0.0f;
+    const auto exactMargin = GravityField::getExactMargin(m_gravityFieldCellSize, bb::GRAVITY_FIELD_EXACT_MARGIN);
+    hash(m_planets.data(), m_planets.size() * sizeof(Planet));
+    hash(&m_gravityFieldCellSize, sizeof(m_gravityFieldCellSize));
+    hash(&theta, sizeof(theta));
+    hash(&bb::BIG_G, sizeof(bb::BIG_G));
+    hash(&exactMargin, sizeof(exactMargin));
+    hash(&bb::GRAVITY_FIELD_PADDING, sizeof(bb::GRAVITY_FIELD_PADDING));
+    // The field's bounds cover the play area
+    hash(&bb::PLAY_AREA_SIZE.x, sizeof(bb::PLAY_AREA_SIZE.x));
+    hash(&bb::PLAY_AREA_SIZE.y, sizeof(bb::PLAY_AREA_SIZE.y));
+
+    auto cachePath = levelPath;
+    cachePath.replace_extension(".gravity");
+    if (m_isGravityFieldCacheEnabled && m_gravityField.loadFromFile(cachePath, key)) {
+        spdlog::debug("Loaded gravity field from {}", cachePath.string());
+        return;
+    }
+
+    // Cover the play area and every planet
+    sf::Vector2f min;
+    sf::Vector2f max { bb::PLAY_AREA_SIZE };
+    std::vector<SpatialGrid::Circle> surfaces;
+    surfaces.reserve(m_planets.size());
     for (const auto& p : m_planets) {
-        target.draw(p.shape, states);
+        min.x = std::min(min.x, p.position.x - p.radius);
+        min.y = std::min(min.y, p.position.y - p.radius);
+        max.x = std::max(max.x, p.position.x + p.radius);
+        max.y = std::max(max.y, p.position.y + p.radius);
+        surfaces.push_back({ p.position, p.radius });
     }
+    const sf::Vector2f padding { bb::GRAVITY_FIELD_PADDING, bb::GRAVITY_FIELD_PADDING };
 
-    for (const auto& o : m_objectives) {
-        if (!o.isActive)
+    m_gravityField.bake(min - padding,
+                        max - min + padding * 2.0f,
+                        m_gravityFieldCellSize,
+                        surfaces,
+                        exactMargin,
+                        [this](const sf::Vector2f& position) { return computeSummedForce(position, 1.0f); });
+    spdlog::debug("Baked gravity field with {} nodes", m_gravityField.getNodeCount());
+
+    if (m_isGravityFieldCacheEnabled && !m_gravityField.saveToFile(cachePath, key))
+        spdlog::warn("Unable to write gravity field cache {}", cachePath.string());
+}
+
+void GameLevel::parseLevelText(const std::filesystem::path& levelPath)
+{
+    std::ifstream levelFile(levelPath, std::ios::in);
+    if (levelFile.fail()) {
+        throw std::runtime_error(fmt::format("Unable to load {} level", levelPath.string()));
+    }
+
+    m_planets.clear();
+    m_objectives.clear();
+
+    std::string line;
+    while (levelFile >> line) {
+        // Skip commented out lines
+        if (line == "#") {
+            levelFile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             continue;
-        target.draw(o.shape, states);
+        }
+
+        // Load start position
+        if (line[0] == 's') {
+            levelFile >> m_playerStart.x >> m_playerStart.y;
+        } else if (line[0] == 'p') // Load planets
+        {
+            Planet p;
+            levelFile >> p.radius >> p.position.x >> p.position.y >> p.mass;
+            m_planets.push_back(p);
+        } else if (line[0] == 'o') // Load objectives
+        {
+            Objective o;
+            levelFile >> o.position.x >> o.position.y;
+            o.isActive = true;
+            m_objectives.push_back(o);
+        }
+    }
+}
+
+auto GameLevel::readCompiledLevel(const std::filesystem::path& compiledPath) -> bool
+{
+    MappedFile file;
+    if (!file.open(compiledPath) || file.getSize() < sizeof(CompiledLevelHeader))
+        return false;
+
+    // Copied out rather than cast, the mapping only promises page alignment
+    // & the arrays aren't padded out to their element alignment
+    CompiledLevelHeader header;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    const auto planetBytes = static_cast<std::uint64_t>(header.planetCount) * sizeof(Planet);
+    const auto objectiveBytes = static_cast<std::uint64_t>(header.objectiveCount) * sizeof(sf::Vector2f);
+    if (header.magic != COMPILED_LEVEL_MAGIC || header.version != COMPILED_LEVEL_VERSION
+        || file.getSize() != sizeof(header) + planetBytes + objectiveBytes)
+        return false;
+
+    m_playerStart = { header.playerStartX, header.playerStartY };
+    const auto* planets = file.getData() + sizeof(header);
+    m_planets.resize(header.planetCount);
+    if (!m_planets.empty())
+        std::memcpy(m_planets.data(), planets, planetBytes);
+
+    const auto* positions = planets + planetBytes;
+    m_objectives.assign(header.objectiveCount, Objective {});
+    for (auto& o : m_objectives) {
+        std::memcpy(&o.position, positions, sizeof(sf::Vector2f));
+        o.isActive = true;
+        positions += sizeof(sf::Vector2f);
     }
+    return true;
 }
+
+auto GameLevel::writeCompiledLevel(const std::filesystem::path& compiledPath) const -> bool
+{
+    std::ofstream file(compiledPath, std::ios::binary | std::ios::trunc);
+    if (file.fail())
+        return false;
+
+    CompiledLevelHeader header;
+    header.magic = COMPILED_LEVEL_MAGIC;
+    header.version = COMPILED_LEVEL_VERSION;
+    header.playerStartX = m_playerStart.x;
+    header.playerStartY = m_playerStart.y;
+    header.planetCount = static_cast<std::uint32_t>(m_planets.size());
+    header.objectiveCount = static_cast<std::uint32_t>(m_objectives.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_planets.data()),
+               static_cast<std::streamsize>(m_planets.size() * sizeof(Planet)));
+    for (const auto& o : m_objectives)
+        file.write(reinterpret_cast<const char*>(&o.position), sizeof(o.position));
+    return file.good();
+}
+
+auto GameLevel::getCurrentLevel() const -> Levels { return m_currentLevel; }
+
+auto GameLevel::getAttemptTotal() const -> std::uint32_t { return m_levelAttempts; }
+
+auto GameLevel::getPlanets() const -> const std::vector<Planet>& { return m_planets; }
+
+auto GameLevel::getObjectives() const -> const std::vector<Objective>& { return m_objectives; }
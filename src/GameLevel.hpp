@@ -1,60 +1,121 @@
 #pragma once
 
-#include <SFML/Audio/Sound.hpp>
-#include <SFML/Audio/SoundBuffer.hpp>
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/Texture.hpp>
+#include "GameplayBlackboard.hpp"
+#include "GravityField.hpp"
+#include "GravityTree.hpp"
+#include "SpatialGrid.hpp"
+
+#include <SFML/System/Angle.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdint>
+#include <filesystem>
 #include <optional>
+#include <vector>
 
-class GameLevel : public sf::Drawable {
+// Pure simulation side of a level, holds no rendering or audio state so
+// it can be driven headless. See LevelRenderer for the drawable side.
+class GameLevel {
 public:
     struct PlanetCollisionInfo {
         sf::Vector2f normal;
         sf::Vector2f point;
+        sf::Vector2f position; // Centre of the moving circle when it touched the planet
+    };
+
+    struct Planet {
+        sf::Vector2f position;
+        float radius { 0.0f };
+        float mass { 0.0f };
+    };
+
+    struct Objective {
+        sf::Vector2f position;
+        sf::Angle rotation;
+        bool isActive { false };
     };
 
     enum class Levels { Developer = 0, One, Two, Three, Four, Five, Six, MAX_LEVEL };
 
     GameLevel();
 
+    static auto getLevelPath(Levels level) -> std::filesystem::path;
+
     void loadLevel(Levels level);
+    // Text levels load from their compiled form when it's at least as new as
+    // the text, see getCompiledPath, & are parsed otherwise. A compiled path
+    // loads just that file.
+    void loadLevel(const std::filesystem::path& levelPath);
+
+    // The compiled level next to a text level, a .lvl file
+    static auto getCompiledPath(const std::filesystem::path& levelPath) -> std::filesystem::path;
+    // Parses a text level & writes it compiled, throws if either fails
+    static void compileLevel(const std::filesystem::path& textPath, const std::filesystem::path& compiledPath);
 
     void update(const sf::Time& dt);
 
     sf::Vector2f getPlayerStart() const { return m_playerStart; }
 
+    // Sampled from the baked gravity field when there is one, otherwise exact
+    // for small levels & approximated by the Barnes-Hut tree once the planet
+    // count reaches bb::BARNES_HUT_MIN_PLANETS
     sf::Vector2f getSummedForce(const sf::Vector2f& pos, float mass) const;
-
-    std::optional<PlanetCollisionInfo> doesCollideWithPlanet(const sf::Vector2f& pos, float radius) const;
-
-    void handleObjectiveIntersections(const sf::Vector2f& pos, float radius);
+    // Opening angle for the Barnes-Hut approximation, zero is exact
+    void setGravityTheta(float theta);
+
+    // Gravity field settings take effect on the next loadLevel. The cache is
+    // a .gravity file next to the level, rebaked when the level changes.
+    void setGravityFieldEnabled(bool enabled);
+    void setGravityFieldCellSize(float cellSize);
+    void setGravityFieldCacheEnabled(bool enabled);
+    // Takes the gravity settings above from another level, for a level
+    // loaded to replace it
+    void copySettings(const GameLevel& other);
+
+    // Collision queries sweep the circle from start to end so nothing is
+    // skipped over when it moves further than its size in one step. Pass the
+    // same point twice for a plain overlap test.
+
+    // First planet the circle touches along the move
+    std::optional<PlanetCollisionInfo>
+    doesCollideWithPlanet(const sf::Vector2f& start, const sf::Vector2f& end, float radius) const;
+
+    // Deactivates any objectives touched along the move, returns how many were collected
+    auto handleObjectiveIntersections(const sf::Vector2f& start, const sf::Vector2f& end, float radius)
+        -> std::uint32_t;
+    // Lowest index active objective touched along the move, leaves it active
+    auto findObjectiveIntersection(const sf::Vector2f& start, const sf::Vector2f& end, float radius) const
+        -> std::optional<std::size_t>;
 
     void resetLevel();
 
     auto isLevelComplete() const -> bool;
     auto getCurrentLevel() const -> Levels;
     auto getAttemptTotal() const -> std::uint32_t;
-
-protected:
-    virtual void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
+    auto getPlanets() const -> const std::vector<Planet>&;
+    auto getObjectives() const -> const std::vector<Objective>&;
 
 private:
-    struct Planet {
-        sf::RectangleShape shape;
-        float mass { 0.0f };
-    };
-
-    struct Objective {
-        sf::RectangleShape shape;
-        bool isActive { false };
-    };
+    void parseLevelText(const std::filesystem::path& levelPath);
+    // Maps the file & copies its arrays in whole, false if it isn't a valid compiled level
+    auto readCompiledLevel(const std::filesystem::path& compiledPath) -> bool;
+    auto writeCompiledLevel(const std::filesystem::path& compiledPath) const -> bool;
+    void buildQueryStructures();
+    void buildGravityField(const std::filesystem::path& levelPath);
+    auto computeSummedForce(const sf::Vector2f& pos, float mass) const -> sf::Vector2f;
 
     std::vector<Planet> m_planets;
     std::vector<Objective> m_objectives;
+    SpatialGrid m_planetGrid;
+    SpatialGrid m_objectiveGrid;
+    GravityTree m_gravityTree;
+    bool m_useGravityTree { false };
+    GravityField m_gravityField;
+    float m_gravityFieldCellSize { bb::GRAVITY_FIELD_CELL_SIZE };
+    bool m_isGravityFieldEnabled { false };
+    bool m_isGravityFieldCacheEnabled { false };
     sf::Vector2f m_playerStart;
-    sf::Sound m_collectObjective;
     Levels m_currentLevel = Levels::Developer;
     std::uint32_t m_levelAttempts { 1 };
-};
\ No newline at end of file
+};
@@ -1,19 +1,41 @@
 #pragma once
 
+#include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
 
 namespace bb {
+// Simulation related
+constexpr auto PHYSICS_TICK_RATE { 120 };
+constexpr auto FIXED_TIME_STEP = sf::seconds(1.0f / static_cast<float>(PHYSICS_TICK_RATE));
+constexpr auto MAX_PHYSICS_SUB_STEPS { 8u };
+constexpr auto MAX_SPEED { 310.0f };
+constexpr auto MAX_ANGULAR_SPEED { 15.0f };
+constexpr auto RADIANS_TO_DEGREES { 180.0f / 3.141592654f };
+
 // Rocket related
 constexpr auto THRUST_FORCE { 2.0e7f };
 constexpr auto TORQUE_MAG { 8.0e3f };
+constexpr auto ROCKET_MASS { 1.0e5f };
+constexpr auto ROCKET_INERTIA { 1.0e3f };
 constexpr auto TRAIL_PARTICLE_COUNT { 50 };
 constexpr sf::Vector2f ROCKET_SIZE { 32.0f, 32.0f };
 constexpr sf::Vector2f PARTICLE_SIZE { 4.0f, 4.0f };
+constexpr auto AIM_ASSIST_TICKS { 240u };
+constexpr auto AIM_ASSIST_SAMPLE_INTERVAL { 4u };
 
 // Level Related
 constexpr auto BIG_G { 6.67e-11f };
+// Levels with at least this many planets use the Barnes-Hut tree for gravity
+constexpr auto BARNES_HUT_MIN_PLANETS { 128u };
+constexpr auto BARNES_HUT_THETA { 0.5f };
+// Baked gravity field, distances in pixels
+constexpr auto GRAVITY_FIELD_CELL_SIZE { 8.0f };
+constexpr auto GRAVITY_FIELD_EXACT_MARGIN { 32.0f };
+constexpr auto GRAVITY_FIELD_PADDING { 200.0f };
 constexpr auto OBJECTIVE_ROTATION_SPEED { 50.0f };
 constexpr sf::Vector2f OBJECTIVE_SIZE { 24.0f, 24.0f };
+constexpr sf::Vector2f PLAY_AREA_SIZE { 800.0f, 600.0f };
+constexpr auto MAX_OOB_TIME { 5 };
 
 // Menu related
 constexpr auto MENU_ORBIT_RADIUS { 200.0f };
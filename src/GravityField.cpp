@@ -0,0 +1,210 @@
+#include "GravityField.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+
+constexpr std::uint32_t FILE_MAGIC { 0x46475249 }; // "IRGF"
+constexpr std::uint32_t FILE_VERSION { 1 };
+
+namespace {
+template <typename T>
+void write_value(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void read_value(std::ifstream& file, T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void write_array(std::ofstream& file, const std::vector<T>& values)
+{
+    file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+void read_array(std::ifstream& file, std::vector<T>& values, std::size_t count)
+{
+    values.resize(count);
+    file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+}
+}
+
+void GravityField::bake(const sf::Vector2f& origin,
+                        const sf::Vector2f& size,
+                        float cellSize,
+                        const std::vector<SpatialGrid::Circle>& surfaces,
+                        float exactMargin,
+                        const AccelerationFunc& accelerationAt)
+{
+    assert(cellSize > 0.0f);
+    clear();
+
+    m_origin = origin;
+    m_cellSize = cellSize;
+    m_columns = std::max(static_cast<std::uint32_t>(std::ceil(size.x / cellSize)), 1u);
+    m_rows = std::max(static_cast<std::uint32_t>(std::ceil(size.y / cellSize)), 1u);
+
+    const auto nodeColumns = m_columns + 1;
+    const auto nodeCount = static_cast<std::size_t>(nodeColumns) * (m_rows + 1);
+    m_accelerationX.resize(nodeCount);
+    m_accelerationY.resize(nodeCount);
+    m_isSteep.assign(nodeCount, 0);
+
+    const auto toNode = [this](float coordinate, float originCoordinate, std::uint32_t cells) {
+        const auto node = std::clamp((coordinate - originCoordinate) / m_cellSize, 0.0f, static_cast<float>(cells));
+        return static_cast<std::uint32_t>(node);
+    };
+
+    // Flag the nodes around each surface first, the field isn't evaluated
+    // there at all since it's never sampled
+    const auto margin = getExactMargin(cellSize, exactMargin);
+    for (const auto& s : surfaces) {
+        const auto reach = s.radius + margin;
+        const auto minColumn = toNode(s.position.x - reach, m_origin.x, m_columns);
+        const auto maxColumn = toNode(s.position.x + reach + m_cellSize, m_origin.x, m_columns);
+        const auto minRow = toNode(s.position.y - reach, m_origin.y, m_rows);
+        const auto maxRow = toNode(s.position.y + reach + m_cellSize, m_origin.y, m_rows);
+        for (auto row = minRow; row <= maxRow; ++row) {
+            for (auto column = minColumn; column <= maxColumn; ++column) {
+                if ((getNodePosition(column, row) - s.position).lengthSq() <= reach * reach)
+                    m_isSteep[row * nodeColumns + column] = 1;
+            }
+        }
+    }
+
+    for (std::uint32_t row = 0; row <= m_rows; ++row) {
+        for (std::uint32_t column = 0; column < nodeColumns; ++column) {
+            const auto index = row * nodeColumns + column;
+            if (m_isSteep[index])
+                continue;
+
+            const auto acceleration = accelerationAt(getNodePosition(column, row));
+            m_accelerationX[index] = acceleration.x;
+            m_accelerationY[index] = acceleration.y;
+        }
+    }
+}
+
+void GravityField::clear()
+{
+    m_columns = m_rows = 0;
+    m_accelerationX.clear();
+    m_accelerationY.clear();
+    m_isSteep.clear();
+}
+
+auto GravityField::getExactMargin(float cellSize, float exactMargin) -> float
+{
+    return std::max(exactMargin, cellSize * std::sqrt(2.0f));
+}
+
+auto GravityField::sample(const sf::Vector2f& position) const -> std::optional<sf::Vector2f>
+{
+    if (m_isSteep.empty())
+        return {};
+
+    const auto cellX = (position.x - m_origin.x) / m_cellSize;
+    const auto cellY = (position.y - m_origin.y) / m_cellSize;
+    // Written so NaN positions fail too
+    if (!(cellX >= 0.0f && cellY >= 0.0f && cellX < static_cast<float>(m_columns)
+          && cellY < static_cast<float>(m_rows)))
+        return {};
+
+    const auto column = static_cast<std::uint32_t>(cellX);
+    const auto row = static_cast<std::uint32_t>(cellY);
+    const auto nodeColumns = m_columns + 1;
+    const auto topLeft = row * nodeColumns + column;
+    const auto bottomLeft = topLeft + nodeColumns;
+    if (m_isSteep[topLeft] || m_isSteep[topLeft + 1] || m_isSteep[bottomLeft] || m_isSteep[bottomLeft + 1])
+        return {};
+
+    const auto tx = cellX - static_cast<float>(column);
+    const auto ty = cellY - static_cast<float>(row);
+    const auto bilinear = [&](const std::vector<float>& values) {
+        const auto top = values[topLeft] + (values[topLeft + 1] - values[topLeft]) * tx;
+        const auto bottom = values[bottomLeft] + (values[bottomLeft + 1] - values[bottomLeft]) * tx;
+        return top + (bottom - top) * ty;
+    };
+    return sf::Vector2f { bilinear(m_accelerationX), bilinear(m_accelerationY) };
+}
+
+auto GravityField::getNodePosition(std::uint32_t column, std::uint32_t row) const -> sf::Vector2f
+{
+    return m_origin + sf::Vector2f { static_cast<float>(column), static_cast<float>(row) } * m_cellSize;
+}
+
+auto GravityField::isBaked() const -> bool { return !m_isSteep.empty(); }
+
+auto GravityField::getNodeCount() const -> std::size_t { return m_isSteep.size(); }
+
+auto GravityField::saveToFile(const std::filesystem::path& path, std::uint64_t key) const -> bool
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file.fail())
+        return false;
+
+    write_value(file, FILE_MAGIC);
+    write_value(file, FILE_VERSION);
+    write_value(file, key);
+    write_value(file, m_origin.x);
+    write_value(file, m_origin.y);
+    write_value(file, m_cellSize);
+    write_value(file, m_columns);
+    write_value(file, m_rows);
+    write_array(file, m_accelerationX);
+    write_array(file, m_accelerationY);
+    write_array(file, m_isSteep);
+    return file.good();
+}
+
+auto GravityField::loadFromFile(const std::filesystem::path& path, std::uint64_t key) -> bool
+{
+    clear();
+    std::ifstream file(path, std::ios::binary);
+    if (file.fail())
+        return false;
+
+    std::uint32_t magic { 0 };
+    std::uint32_t version { 0 };
+    std::uint64_t fileKey { 0 };
+    read_value(file, magic);
+    read_value(file, version);
+    read_value(file, fileKey);
+    if (!file.good() || magic != FILE_MAGIC || version != FILE_VERSION || fileKey != key)
+        return false;
+
+    read_value(file, m_origin.x);
+    read_value(file, m_origin.y);
+    read_value(file, m_cellSize);
+    read_value(file, m_columns);
+    read_value(file, m_rows);
+    if (!file.good() || !(m_cellSize > 0.0f)) {
+        clear();
+        return false;
+    }
+
+    // Checked before allocating so a damaged header can't ask for gigabytes
+    const auto nodeCount = static_cast<std::size_t>(m_columns + 1) * (m_rows + 1);
+    const auto headerSize = static_cast<std::uintmax_t>(file.tellg());
+    const auto expectedSize = headerSize + nodeCount * (sizeof(float) * 2 + sizeof(std::uint8_t));
+    std::error_code error;
+    if (std::filesystem::file_size(path, error) != expectedSize || error) {
+        clear();
+        return false;
+    }
+
+    read_array(file, m_accelerationX, nodeCount);
+    read_array(file, m_accelerationY, nodeCount);
+    read_array(file, m_isSteep, nodeCount);
+    if (!file.good()) {
+        clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "SpatialGrid.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <vector>
+
+// Gravitational acceleration baked onto a regular grid of nodes for a static
+// level and sampled bilinearly. Nodes close to a planet surface, where the
+// field is too steep to interpolate, are flagged and sampling near them
+// returns nothing so the caller can evaluate the field exactly.
+class GravityField {
+public:
+    using AccelerationFunc = std::function<sf::Vector2f(const sf::Vector2f& position)>;
+
+    // Covers origin to origin + size, exactMargin is how far outside each
+    // surface the exact fallback is used, see getExactMargin
+    void bake(const sf::Vector2f& origin,
+              const sf::Vector2f& size,
+              float cellSize,
+              const std::vector<SpatialGrid::Circle>& surfaces,
+              float exactMargin,
+              const AccelerationFunc& accelerationAt);
+    void clear();
+
+    // The margin bake actually uses, at least a cell's diagonal so a cell
+    // holding part of a surface always has a flagged node
+    static auto getExactMargin(float cellSize, float exactMargin) -> float;
+
+    auto sample(const sf::Vector2f& position) const -> std::optional<sf::Vector2f>;
+    auto isBaked() const -> bool;
+    auto getNodeCount() const -> std::size_t;
+
+    // The key identifies what the field was baked from, loading fails if the
+    // file was written with a different key or version
+    auto saveToFile(const std::filesystem::path& path, std::uint64_t key) const -> bool;
+    auto loadFromFile(const std::filesystem::path& path, std::uint64_t key) -> bool;
+
+private:
+    auto getNodePosition(std::uint32_t column, std::uint32_t row) const -> sf::Vector2f;
+
+    sf::Vector2f m_origin;
+    float m_cellSize { 1.0f };
+    std::uint32_t m_columns { 0 }; // Cells, there is one more node than cells on each axis
+    std::uint32_t m_rows { 0 };
+    std::vector<float> m_accelerationX;
+    std::vector<float> m_accelerationY;
+    std::vector<std::uint8_t> m_isSteep;
+};
@@ -0,0 +1,147 @@
+#include "GravityTree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+constexpr std::uint32_t MAX_LEAF_SIZE { 8 };
+// Stops subdividing coincident masses forever
+constexpr std::uint32_t MAX_DEPTH { 24 };
+
+void GravityTree::build(const std::vector<Mass>& masses)
+{
+    clear();
+    if (masses.empty())
+        return;
+
+    sf::Vector2f min { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    sf::Vector2f max { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+    for (const auto& m : masses) {
+        min.x = std::min(min.x, m.position.x);
+        min.y = std::min(min.y, m.position.y);
+        max.x = std::max(max.x, m.position.x);
+        max.y = std::max(max.y, m.position.y);
+        m_positionX.push_back(m.position.x);
+        m_positionY.push_back(m.position.y);
+        m_mass.push_back(m.mass);
+    }
+
+    m_nodes.push_back({});
+    m_nodes.front().count = static_cast<std::uint32_t>(masses.size());
+    const auto halfWidth = std::max(std::max(max.x - min.x, max.y - min.y) * 0.5f, 1.0f);
+    buildNode(0, (min + max) * 0.5f, halfWidth, 0);
+}
+
+void GravityTree::clear()
+{
+    m_nodes.clear();
+    m_positionX.clear();
+    m_positionY.clear();
+    m_mass.clear();
+}
+
+void GravityTree::setTheta(float theta)
+{
+    assert(theta >= 0.0f);
+    m_thetaSq = theta * theta;
+}
+
+auto GravityTree::getTheta() const -> float { return std::sqrt(m_thetaSq); }
+
+auto GravityTree::getField(const sf::Vector2f& position) const -> sf::Vector2f
+{
+    sf::Vector2f sum;
+    if (m_nodes.empty())
+        return sum;
+
+    const auto addMass = [&sum, &position](float x, float y, float mass) {
+        const sf::Vector2f delta { x - position.x, y - position.y };
+        const float radiusSq = delta.lengthSq();
+        sum += delta * (mass / (radiusSq * std::sqrt(radiusSq)));
+    };
+
+    std::uint32_t stack[MAX_DEPTH * 3 + 1];
+    std::uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const auto& node = m_nodes[stack[--stackSize]];
+        if (node.firstChild == 0) {
+            for (auto i = node.first; i < node.first + node.count; ++i)
+                addMass(m_positionX[i], m_positionY[i], m_mass[i]);
+            continue;
+        }
+
+        const auto distanceSq = (node.centreOfMass - position).lengthSq();
+        if (node.width * node.width < m_thetaSq * distanceSq) {
+            addMass(node.centreOfMass.x, node.centreOfMass.y, node.mass);
+            continue;
+        }
+
+        for (std::uint32_t child = 0; child < 4; ++child) {
+            if (m_nodes[node.firstChild + child].count > 0)
+                stack[stackSize++] = node.firstChild + child;
+        }
+    }
+    return sum;
+}
+
+auto GravityTree::getNodeCount() const -> std::size_t { return m_nodes.size(); }
+
+void GravityTree::buildNode(std::uint32_t nodeIndex, sf::Vector2f centre, float halfWidth, std::uint32_t depth)
+{
+    const auto first = m_nodes[nodeIndex].first;
+    const auto count = m_nodes[nodeIndex].count;
+    const auto last = first + count;
+
+    sf::Vector2f weighted;
+    float mass = 0.0f;
+    for (auto i = first; i < last; ++i) {
+        weighted += sf::Vector2f { m_positionX[i], m_positionY[i] } * m_mass[i];
+        mass += m_mass[i];
+    }
+
+    {
+        auto& node = m_nodes[nodeIndex];
+        node.mass = mass;
+        node.width = halfWidth * 2.0f;
+        node.centreOfMass = mass != 0.0f ? weighted / mass : centre;
+    }
+
+    if (count <= MAX_LEAF_SIZE || depth == MAX_DEPTH)
+        return;
+
+    // Partition the range into the four quadrants, in place
+    const auto swapMasses = [this](std::uint32_t a, std::uint32_t b) {
+        std::swap(m_positionX[a], m_positionX[b]);
+        std::swap(m_positionY[a], m_positionY[b]);
+        std::swap(m_mass[a], m_mass[b]);
+    };
+    const auto partition = [&](std::uint32_t begin, std::uint32_t end, auto&& isLow) {
+        auto split = begin;
+        for (auto i = begin; i < end; ++i) {
+            if (isLow(i))
+                swapMasses(i, split++);
+        }
+        return split;
+    };
+
+    const auto splitY = partition(first, last, [&](std::uint32_t i) { return m_positionY[i] < centre.y; });
+    const auto splitTop = partition(first, splitY, [&](std::uint32_t i) { return m_positionX[i] < centre.x; });
+    const auto splitBottom = partition(splitY, last, [&](std::uint32_t i) { return m_positionX[i] < centre.x; });
+
+    const auto firstChild = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes[nodeIndex].firstChild = firstChild;
+    m_nodes.resize(m_nodes.size() + 4);
+
+    const std::uint32_t bounds[5] = { first, splitTop, splitY, splitBottom, last };
+    const auto quarter = halfWidth * 0.5f;
+    const sf::Vector2f offsets[4]
+        = { { -quarter, -quarter }, { quarter, -quarter }, { -quarter, quarter }, { quarter, quarter } };
+    for (std::uint32_t child = 0; child < 4; ++child) {
+        m_nodes[firstChild + child].first = bounds[child];
+        m_nodes[firstChild + child].count = bounds[child + 1] - bounds[child];
+        if (m_nodes[firstChild + child].count > 0)
+            buildNode(firstChild + child, centre + offsets[child], quarter, depth + 1);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Barnes-Hut quadtree over static point masses. Distant groups of masses are
+// treated as a single mass at their centre of mass, controlled by the
+// opening angle theta: a node is approximated when its width is less than
+// theta times its distance from the query point. Zero theta gives the exact
+// sum, larger values are faster and less accurate.
+class GravityTree {
+public:
+    struct Mass {
+        sf::Vector2f position;
+        float mass { 0.0f };
+    };
+
+    void build(const std::vector<Mass>& masses);
+    void clear();
+
+    void setTheta(float theta);
+    auto getTheta() const -> float;
+
+    // Sum of mass * direction / distance^2 towards every mass, scale by
+    // G * body mass to get the force on a body
+    auto getField(const sf::Vector2f& position) const -> sf::Vector2f;
+
+    auto getNodeCount() const -> std::size_t;
+
+private:
+    struct Node {
+        sf::Vector2f centreOfMass;
+        float mass { 0.0f };
+        float width { 0.0f };
+        std::uint32_t firstChild { 0 }; // Four consecutive nodes, zero for leaves
+        std::uint32_t first { 0 }; // Range in the masses, leaves only
+        std::uint32_t count { 0 };
+    };
+
+    void buildNode(std::uint32_t nodeIndex, sf::Vector2f centre, float halfWidth, std::uint32_t depth);
+
+    std::vector<Node> m_nodes;
+    std::vector<float> m_positionX; // Reordered so each leaf is contiguous
+    std::vector<float> m_positionY;
+    std::vector<float> m_mass;
+    float m_thetaSq { 0.25f };
+};
@@ -1,4 +1,5 @@
 #include "InputHandler.hpp"
+#include "Profiler.hpp"
 
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/Joystick.hpp>
@@ -30,6 +31,7 @@ InputHandler& InputHandler::get()
 
 void InputHandler::handleEvents(sf::RenderWindow& window)
 {
+    PROFILE_ZONE("InputHandler::handleEvents");
     // Maybe this could be improved upon to make
     // adding things like this less painful...
     m_resetPressed = false;
@@ -72,6 +74,8 @@ void InputHandler::handleEvents(sf::RenderWindow& window)
 
 auto InputHandler::getInputState() const -> InputState { return m_state; }
 
+void InputHandler::setInputState(const InputState& state) { m_state = state; }
+
 auto InputHandler::wasResetPressed() const -> bool { return m_resetPressed; }
 
 auto InputHandler::debugSkipPressed() const -> bool { return m_debugSkipPressed; }
@@ -2,12 +2,11 @@
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include "InputState.hpp"
+
 class InputHandler {
 public:
-    struct InputState {
-        float linear_thrust { 0.0f }; // +ve = forward, -ve = backwards
-        float angular_thrust { 0.0f }; // +ve clockwise, -ve anticlockwise
-    };
+    using InputState = ::InputState;
 
     enum class PadType { Xbox_Pad, DS4_Pad };
 
@@ -15,6 +14,9 @@ public:
     void handleEvents(sf::RenderWindow& window);
 
     auto getInputState() const -> InputState;
+    // Holds the input as if the player were until their own input replaces
+    // it, for driving the game without a player
+    void setInputState(const InputState& state);
     auto wasResetPressed() const -> bool;
     auto debugSkipPressed() const -> bool;
     auto getMousePosition() const -> sf::Vector2f;
@@ -0,0 +1,187 @@
+#include "InputRecording.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <spdlog/fmt/fmt.h>
+
+constexpr std::uint32_t FILE_MAGIC { 0x43525249 }; // "IRRC"
+constexpr std::uint32_t FILE_VERSION { 1 };
+constexpr std::uint32_t MAX_PATH_LENGTH { 4096 };
+// Input changes, resets & loads, about an hour of steady play
+constexpr std::size_t RESERVED_EVENT_COUNT { 16 * 1024 };
+
+namespace {
+template <typename T>
+void write_value(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+auto read_value(std::ifstream& file) -> T
+{
+    T value {};
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+// Inputs are compared bitwise, the replay has to see exactly what was recorded
+bool is_same_input(const InputState& a, const InputState& b) { return std::memcmp(&a, &b, sizeof(InputState)) == 0; }
+}
+
+InputRecording::InputRecording() { m_events.reserve(RESERVED_EVENT_COUNT); }
+
+void InputRecording::clear()
+{
+    m_events.clear();
+    m_tickCount = 0;
+}
+
+void InputRecording::recordTick(const InputState& input)
+{
+    ++m_tickCount;
+    if (!m_events.empty()) {
+        auto& last = m_events.back();
+        if (last.type == EventType::Input && is_same_input(last.input, input)
+            && last.tickCount < std::numeric_limits<std::uint32_t>::max()) {
+            ++last.tickCount;
+            return;
+        }
+    }
+
+    Event event;
+    event.type = EventType::Input;
+    event.tickCount = 1;
+    event.input = input;
+    m_events.push_back(event);
+}
+
+void InputRecording::recordReset()
+{
+    Event event;
+    event.type = EventType::Reset;
+    m_events.push_back(event);
+}
+
+void InputRecording::recordHalt()
+{
+    Event event;
+    event.type = EventType::Halt;
+    m_events.push_back(event);
+}
+
+void InputRecording::recordLevelLoad(GameLevel::Levels level)
+{
+    Event event;
+    event.type = EventType::LoadLevel;
+    event.level = level;
+    m_events.push_back(event);
+}
+
+void InputRecording::recordLevelLoad(const std::filesystem::path& levelPath)
+{
+    Event event;
+    event.type = EventType::LoadLevel;
+    event.levelPath = levelPath.generic_string();
+    m_events.push_back(event);
+}
+
+void InputRecording::recordTimeStep(const sf::Time& timeStep)
+{
+    Event event;
+    event.type = EventType::TimeStep;
+    event.timeStep = timeStep;
+    m_events.push_back(event);
+}
+
+void InputRecording::saveToFile(const std::filesystem::path& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to write input recording {}", path.string()));
+
+    write_value(file, FILE_MAGIC);
+    write_value(file, FILE_VERSION);
+    write_value(file, static_cast<std::uint64_t>(m_events.size()));
+    for (const auto& e : m_events) {
+        write_value(file, e.type);
+        switch (e.type) {
+        case EventType::Input:
+            write_value(file, e.tickCount);
+            write_value(file, e.input.linear_thrust);
+            write_value(file, e.input.angular_thrust);
+            break;
+        case EventType::LoadLevel:
+            write_value(file, static_cast<std::uint32_t>(e.level));
+            write_value(file, static_cast<std::uint32_t>(e.levelPath.size()));
+            file.write(e.levelPath.data(), static_cast<std::streamsize>(e.levelPath.size()));
+            break;
+        case EventType::TimeStep:
+            write_value(file, static_cast<std::int64_t>(e.timeStep.asMicroseconds()));
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!file.good())
+        throw std::runtime_error(fmt::format("Unable to write input recording {}", path.string()));
+}
+
+void InputRecording::loadFromFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to load input recording {}", path.string()));
+
+    const auto malformed = [&path] {
+        return std::runtime_error(fmt::format("Malformed input recording {}", path.string()));
+    };
+
+    if (read_value<std::uint32_t>(file) != FILE_MAGIC || read_value<std::uint32_t>(file) != FILE_VERSION)
+        throw malformed();
+
+    clear();
+    const auto eventCount = read_value<std::uint64_t>(file);
+    for (std::uint64_t i = 0; i < eventCount && file.good(); ++i) {
+        Event e;
+        e.type = read_value<EventType>(file);
+        switch (e.type) {
+        case EventType::Input:
+            e.tickCount = read_value<std::uint32_t>(file);
+            e.input.linear_thrust = read_value<float>(file);
+            e.input.angular_thrust = read_value<float>(file);
+            m_tickCount += e.tickCount;
+            break;
+        case EventType::LoadLevel: {
+            const auto level = read_value<std::uint32_t>(file);
+            if (level > static_cast<std::uint32_t>(GameLevel::Levels::MAX_LEVEL))
+                throw malformed();
+            e.level = static_cast<GameLevel::Levels>(level);
+            const auto pathLength = read_value<std::uint32_t>(file);
+            if (pathLength > MAX_PATH_LENGTH)
+                throw malformed();
+            e.levelPath.resize(pathLength);
+            file.read(e.levelPath.data(), static_cast<std::streamsize>(e.levelPath.size()));
+            break;
+        }
+        case EventType::TimeStep:
+            e.timeStep = sf::microseconds(read_value<std::int64_t>(file));
+            break;
+        case EventType::Reset:
+        case EventType::Halt:
+            break;
+        default:
+            throw malformed();
+        }
+        m_events.push_back(e);
+    }
+
+    if (!file.good())
+        throw malformed();
+}
+
+auto InputRecording::getEvents() const -> const std::vector<Event>& { return m_events; }
+
+auto InputRecording::getTickCount() const -> std::uint64_t { return m_tickCount; }
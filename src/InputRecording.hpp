@@ -0,0 +1,58 @@
+#pragma once
+
+#include "GameLevel.hpp"
+#include "InputState.hpp"
+
+#include <SFML/System/Time.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Everything that drives the fixed-step simulation, recorded per tick so a
+// run can be replayed bit for bit. Repeated inputs are run length encoded,
+// so a recording stays small. Anything that happens between ticks (level
+// resets, loads, tick rate changes) is stored as an event in tick order.
+class InputRecording {
+public:
+    enum class EventType : std::uint8_t {
+        Input = 0, // Input held for tickCount ticks
+        Reset, // Level reset & rocket back at the start
+        LoadLevel,
+        TimeStep, // Fixed step used from here on
+        Halt // Debug halt of the rocket
+    };
+
+    struct Event {
+        EventType type { EventType::Input };
+        std::uint32_t tickCount { 0 };
+        InputState input {};
+        GameLevel::Levels level { GameLevel::Levels::MAX_LEVEL }; // MAX_LEVEL when loaded by path
+        std::string levelPath;
+        sf::Time timeStep;
+    };
+
+    // Room for a long session's events is reserved up front, so recording
+    // doesn't allocate during play
+    InputRecording();
+
+    void clear();
+
+    void recordTick(const InputState& input);
+    void recordReset();
+    void recordHalt();
+    void recordLevelLoad(GameLevel::Levels level);
+    void recordLevelLoad(const std::filesystem::path& levelPath);
+    void recordTimeStep(const sf::Time& timeStep);
+
+    void saveToFile(const std::filesystem::path& path) const;
+    void loadFromFile(const std::filesystem::path& path);
+
+    auto getEvents() const -> const std::vector<Event>&;
+    auto getTickCount() const -> std::uint64_t;
+
+private:
+    std::vector<Event> m_events;
+    std::uint64_t m_tickCount { 0 };
+};
@@ -0,0 +1,44 @@
+#include "InputScript.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <spdlog/fmt/fmt.h>
+#include <string>
+
+void InputScript::loadFromFile(const std::filesystem::path& path)
+{
+    std::ifstream scriptFile(path, std::ios::in);
+    if (scriptFile.fail())
+        throw std::runtime_error(fmt::format("Unable to load input script {}", path.string()));
+
+    m_segments.clear();
+    std::uint64_t endTick = 0;
+    std::string line;
+    while (std::getline(scriptFile, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream lineStream(line);
+        std::uint64_t ticks = 0;
+        InputState input;
+        if (!(lineStream >> ticks >> input.linear_thrust >> input.angular_thrust))
+            throw std::runtime_error(fmt::format("Malformed input script line \"{}\" in {}", line, path.string()));
+
+        endTick += ticks;
+        m_segments.push_back({ endTick, input });
+    }
+}
+
+auto InputScript::getInput(std::uint64_t tick) const -> InputState
+{
+    const auto segment = std::upper_bound(
+        m_segments.begin(), m_segments.end(), tick, [](std::uint64_t t, const Segment& s) { return t < s.endTick; });
+
+    if (segment == m_segments.end())
+        return {};
+
+    return segment->input;
+}
+
+auto InputScript::getTickCount() const -> std::uint64_t { return m_segments.empty() ? 0 : m_segments.back().endTick; }
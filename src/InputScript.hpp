@@ -0,0 +1,27 @@
+#pragma once
+
+#include "InputState.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Scripted input stream for the headless simulator. Each line of the file is
+// <ticks> <linear_thrust> <angular_thrust>, holding that input for the given
+// number of fixed ticks. Lines starting with # are comments.
+class InputScript {
+public:
+    void loadFromFile(const std::filesystem::path& path);
+
+    // Input for the given tick, zero input once the script has run out
+    auto getInput(std::uint64_t tick) const -> InputState;
+    auto getTickCount() const -> std::uint64_t;
+
+private:
+    struct Segment {
+        std::uint64_t endTick { 0 };
+        InputState input;
+    };
+
+    std::vector<Segment> m_segments;
+};
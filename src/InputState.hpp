@@ -0,0 +1,6 @@
+#pragma once
+
+struct InputState {
+    float linear_thrust { 0.0f }; // +ve = forward, -ve = backwards
+    float angular_thrust { 0.0f }; // +ve clockwise, -ve anticlockwise
+};
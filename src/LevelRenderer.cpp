@@ -0,0 +1,58 @@
+#include "LevelRenderer.hpp"
+#include "AssetHolder.hpp"
+#include "GameplayBlackboard.hpp"
+
+#include <cassert>
+
+LevelRenderer::LevelRenderer(const GameLevel& level)
+    : m_level(level)
+{
+}
+
+void LevelRenderer::rebuild()
+{
+    const auto planetRegion = AssetHolder::get().getAtlasRegion(AssetId::Textures_Planet);
+    const auto objectiveRegion = AssetHolder::get().getAtlasRegion(AssetId::Textures_Objective_Ring);
+
+    m_planetShapes.clear();
+    for (const auto& p : m_level.getPlanets()) {
+        sf::RectangleShape shape { { p.radius * 2.f, p.radius * 2.f } };
+        shape.setOrigin({ p.radius, p.radius });
+        shape.setPosition(p.position);
+        shape.setTexture(planetRegion.texture);
+        shape.setTextureRect(planetRegion.rect);
+        m_planetShapes.push_back(shape);
+    }
+
+    m_objectiveShapes.clear();
+    for (const auto& o : m_level.getObjectives()) {
+        sf::RectangleShape shape { bb::OBJECTIVE_SIZE };
+        shape.setOrigin(bb::OBJECTIVE_SIZE * 0.5f);
+        shape.setTexture(objectiveRegion.texture);
+        shape.setTextureRect(objectiveRegion.rect);
+        shape.setPosition(o.position);
+        m_objectiveShapes.push_back(shape);
+    }
+}
+
+void LevelRenderer::update()
+{
+    const auto& objectives = m_level.getObjectives();
+    assert(objectives.size() == m_objectiveShapes.size());
+    for (std::size_t i = 0; i < objectives.size(); ++i)
+        m_objectiveShapes[i].setRotation(objectives[i].rotation);
+}
+
+void LevelRenderer::addTo(SpriteBatch& batch) const
+{
+    for (const auto& p : m_planetShapes) {
+        batch.add(p);
+    }
+
+    const auto& objectives = m_level.getObjectives();
+    for (std::size_t i = 0; i < m_objectiveShapes.size(); ++i) {
+        if (!objectives[i].isActive)
+            continue;
+        batch.add(m_objectiveShapes[i]);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "GameLevel.hpp"
+#include "SpriteBatch.hpp"
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <vector>
+
+class LevelRenderer {
+public:
+    LevelRenderer(const GameLevel& level);
+
+    // Recreates the shapes, must be called after GameLevel::loadLevel
+    void rebuild();
+    void update();
+    // Queues every planet & active objective, they all share the sprite atlas
+    void addTo(SpriteBatch& batch) const;
+
+private:
+    const GameLevel& m_level;
+    std::vector<sf::RectangleShape> m_planetShapes;
+    std::vector<sf::RectangleShape> m_objectiveShapes;
+};
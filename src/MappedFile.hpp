@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Read only view of a whole file mapped into memory, pages are read in by
+// the OS as they're touched. The view is valid until the file is closed or
+// the object destroyed.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Closes any file already open, returns false if the file can't be mapped
+    auto open(const std::filesystem::path& path) -> bool;
+    void close();
+
+    auto getData() const -> const std::uint8_t*;
+    auto getSize() const -> std::size_t;
+
+private:
+    const std::uint8_t* m_data { nullptr };
+    std::size_t m_size { 0 };
+#if defined(_WIN32)
+    void* m_file { nullptr };
+    void* m_mapping { nullptr };
+#endif
+};
@@ -7,9 +7,13 @@
 MenuState::MenuState(sf::RenderWindow& window)
     : BaseState(window)
 {
-    auto const font = AssetHolder::get().getFont("bin/fonts/VCR_OSD_MONO_1.001.ttf");
-    auto const backgroundTex = AssetHolder::get().getTexture("bin/textures/background_resized.png");
-    auto const rocketTexture = AssetHolder::get().getTexture("bin/textures/ship.png");
+    // Requested together so they decode in parallel
+    auto const fontLoad = AssetHolder::get().loadFont(AssetId::Fonts_VCR_OSD_MONO_1_001);
+    AssetHolder::get().loadTexture(AssetId::Textures_Background_Resized);
+    AssetHolder::get().loadTexture(AssetId::Textures_Ship);
+    auto const font = fontLoad.get();
+    auto const backgroundTex = AssetHolder::get().getTexture(AssetId::Textures_Background_Resized);
+    auto const rocketTexture = AssetHolder::get().getTexture(AssetId::Textures_Ship);
     m_playText.setFont(*font);
     m_playText.setString("PLAY");
 
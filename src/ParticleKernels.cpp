@@ -0,0 +1,69 @@
+#include "ParticleKernels.hpp"
+
+#include <cassert>
+
+void advance_particles(ParticleKernel kernel, const ParticleArrays& particles, float dt)
+{
+    assert(is_integrator_kernel_supported(kernel));
+    switch (kernel) {
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS)
+    case ParticleKernel::SSE41:
+        advance_particles_sse41(particles, dt);
+        break;
+    case ParticleKernel::AVX2:
+        advance_particles_avx2(particles, dt);
+        break;
+#endif
+    default:
+        advance_particles_scalar(particles, 0, dt);
+        break;
+    }
+}
+
+void shade_particles(ParticleKernel kernel,
+                     const float* age,
+                     std::size_t count,
+                     float invLifetime,
+                     const sf::Color& start,
+                     const sf::Color& end,
+                     std::uint32_t* colours)
+{
+    assert(is_integrator_kernel_supported(kernel));
+    switch (kernel) {
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS)
+    case ParticleKernel::SSE41:
+        shade_particles_sse41(age, count, invLifetime, start, end, colours);
+        break;
+    case ParticleKernel::AVX2:
+        shade_particles_avx2(age, count, invLifetime, start, end, colours);
+        break;
+#endif
+    default:
+        shade_particles_scalar(age, 0, count, invLifetime, start, end, colours);
+        break;
+    }
+}
+
+void advance_particles_scalar(const ParticleArrays& particles, std::size_t first, float dt)
+{
+    for (auto i = first; i < particles.count; ++i) {
+        particles.positionX[i] += particles.velocityX[i] * dt;
+        particles.positionY[i] += particles.velocityY[i] * dt;
+        particles.age[i] += dt;
+    }
+}
+
+void shade_particles_scalar(const float* age,
+                            std::size_t first,
+                            std::size_t count,
+                            float invLifetime,
+                            const sf::Color& start,
+                            const sf::Color& end,
+                            std::uint32_t* colours)
+{
+    for (auto i = first; i < count; ++i) {
+        const auto weight = get_colour_weight(age[i], invLifetime);
+        colours[i] = blend_channel(start.r, end.r, weight) | blend_channel(start.g, end.g, weight) << 8
+            | blend_channel(start.b, end.b, weight) << 16 | blend_channel(start.a, end.a, weight) << 24;
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "PhysicsKernels.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// Same instruction sets & CPU detection as the integrator kernels
+using ParticleKernel = IntegratorKernel;
+
+// Views into a particle pool's arrays, every array holds count elements
+struct ParticleArrays {
+    float* positionX { nullptr };
+    float* positionY { nullptr };
+    const float* velocityX { nullptr };
+    const float* velocityY { nullptr };
+    float* age { nullptr }; // Seconds
+    std::size_t count { 0 };
+};
+
+// How an effect's particles are drawn, known at compile time so the quad
+// writer can be instantiated per effect
+struct ParticleLook {
+    sf::Vector2f size;
+    sf::Color colourStart;
+    sf::Color colourEnd;
+};
+
+using ParticleQuadWriter = void (*)(ParticleKernel kernel,
+                                    const ParticleArrays& particles,
+                                    std::size_t begin,
+                                    std::size_t end,
+                                    float invLifetime,
+                                    sf::Vertex* vertices);
+
+// Colours are blended in 8 bit fixed point, the weight is how far through
+// its life the particle is out of 256
+inline auto get_colour_weight(float age, float invLifetime) -> std::int32_t
+{
+    const float t = age * invLifetime;
+    return static_cast<std::int32_t>((t < 1.0f ? t : 1.0f) * 256.0f);
+}
+
+inline auto blend_channel(std::int32_t start, std::int32_t end, std::int32_t weight) -> std::uint32_t
+{
+    return static_cast<std::uint32_t>((start * (256 - weight) + end * weight) >> 8);
+}
+
+// Moves every particle by its velocity & ages it by dt
+void advance_particles(ParticleKernel kernel, const ParticleArrays& particles, float dt);
+// Blended colour of each of the count particles, packed r, g, b, a from the low byte up
+void shade_particles(ParticleKernel kernel,
+                     const float* age,
+                     std::size_t count,
+                     float invLifetime,
+                     const sf::Color& start,
+                     const sf::Color& end,
+                     std::uint32_t* colours);
+
+void advance_particles_scalar(const ParticleArrays& particles, std::size_t first, float dt);
+void shade_particles_scalar(const float* age,
+                            std::size_t first,
+                            std::size_t count,
+                            float invLifetime,
+                            const sf::Color& start,
+                            const sf::Color& end,
+                            std::uint32_t* colours);
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS)
+void advance_particles_sse41(const ParticleArrays& particles, float dt);
+void advance_particles_avx2(const ParticleArrays& particles, float dt);
+void shade_particles_sse41(const float* age,
+                           std::size_t count,
+                           float invLifetime,
+                           const sf::Color& start,
+                           const sf::Color& end,
+                           std::uint32_t* colours);
+void shade_particles_avx2(const float* age,
+                          std::size_t count,
+                          float invLifetime,
+                          const sf::Color& start,
+                          const sf::Color& end,
+                          std::uint32_t* colours);
+#endif
+
+// Writes six vertex positions & colours per particle in [begin, end), texture
+// coordinates are left alone. Colours are shaded a batch at a time with the
+// SIMD kernel, then every vertex is a plain store.
+template <const ParticleLook& look>
+void write_particle_quads(ParticleKernel kernel,
+                          const ParticleArrays& particles,
+                          std::size_t begin,
+                          std::size_t end,
+                          float invLifetime,
+                          sf::Vertex* vertices)
+{
+    constexpr std::size_t BATCH_SIZE { 256 };
+    constexpr auto halfSize = look.size / 2.0f;
+
+    std::uint32_t colours[BATCH_SIZE];
+    for (auto batch = begin; batch < end; batch += BATCH_SIZE) {
+        const auto batchEnd = batch + BATCH_SIZE < end ? batch + BATCH_SIZE : end;
+        shade_particles(
+            kernel, particles.age + batch, batchEnd - batch, invLifetime, look.colourStart, look.colourEnd, colours);
+
+        for (auto i = batch; i < batchEnd; ++i) {
+            const auto packed = colours[i - batch];
+            const sf::Color colour { static_cast<std::uint8_t>(packed),
+                                     static_cast<std::uint8_t>(packed >> 8),
+                                     static_cast<std::uint8_t>(packed >> 16),
+                                     static_cast<std::uint8_t>(packed >> 24) };
+            const sf::Vector2f topLeft { particles.positionX[i] - halfSize.x, particles.positionY[i] - halfSize.y };
+            const sf::Vector2f bottomRight { particles.positionX[i] + halfSize.x,
+                                             particles.positionY[i] + halfSize.y };
+
+            sf::Vertex* v = vertices + i * 6;
+            v[0].position = topLeft;
+            v[1].position = { bottomRight.x, topLeft.y };
+            v[2].position = bottomRight;
+            v[3].position = bottomRight;
+            v[4].position = { topLeft.x, bottomRight.y };
+            v[5].position = topLeft;
+            for (std::size_t j = 0; j < 6; ++j)
+                v[j].color = colour;
+        }
+    }
+}
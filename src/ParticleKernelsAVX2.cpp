@@ -0,0 +1,58 @@
+// Built with AVX2 enabled, only called once the CPU has been checked for support
+#include "ParticleKernels.hpp"
+
+#include <immintrin.h>
+
+void advance_particles_avx2(const ParticleArrays& particles, float dt)
+{
+    const __m256 step = _mm256_set1_ps(dt);
+
+    std::size_t i = 0;
+    for (; i + 8 <= particles.count; i += 8) {
+        const __m256 positionX = _mm256_loadu_ps(particles.positionX + i);
+        const __m256 positionY = _mm256_loadu_ps(particles.positionY + i);
+        const __m256 velocityX = _mm256_loadu_ps(particles.velocityX + i);
+        const __m256 velocityY = _mm256_loadu_ps(particles.velocityY + i);
+        _mm256_storeu_ps(particles.positionX + i, _mm256_add_ps(positionX, _mm256_mul_ps(velocityX, step)));
+        _mm256_storeu_ps(particles.positionY + i, _mm256_add_ps(positionY, _mm256_mul_ps(velocityY, step)));
+        _mm256_storeu_ps(particles.age + i, _mm256_add_ps(_mm256_loadu_ps(particles.age + i), step));
+    }
+
+    advance_particles_scalar(particles, i, dt);
+}
+
+void shade_particles_avx2(const float* age,
+                          std::size_t count,
+                          float invLifetime,
+                          const sf::Color& start,
+                          const sf::Color& end,
+                          std::uint32_t* colours)
+{
+    const __m256 scale = _mm256_set1_ps(invLifetime);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 fixedOne = _mm256_set1_ps(256.0f);
+    const __m256i full = _mm256_set1_epi32(256);
+    const auto blend = [](std::uint8_t startChannel, std::uint8_t endChannel, __m256i startWeight, __m256i weight) {
+        const __m256i fromStart = _mm256_mullo_epi32(_mm256_set1_epi32(startChannel), startWeight);
+        const __m256i fromEnd = _mm256_mullo_epi32(_mm256_set1_epi32(endChannel), weight);
+        return _mm256_srai_epi32(_mm256_add_epi32(fromStart, fromEnd), 8);
+    };
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // get_colour_weight, min keeps t when it's below one like the scalar compare
+        const __m256 t = _mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(age + i), scale), one);
+        const __m256i weight = _mm256_cvttps_epi32(_mm256_mul_ps(t, fixedOne));
+        const __m256i startWeight = _mm256_sub_epi32(full, weight);
+
+        // blend_channel for each channel, packed r, g, b, a from the low byte up
+        const __m256i red = blend(start.r, end.r, startWeight, weight);
+        const __m256i green = _mm256_slli_epi32(blend(start.g, end.g, startWeight, weight), 8);
+        const __m256i blue = _mm256_slli_epi32(blend(start.b, end.b, startWeight, weight), 16);
+        const __m256i alpha = _mm256_slli_epi32(blend(start.a, end.a, startWeight, weight), 24);
+        const __m256i packed = _mm256_or_si256(_mm256_or_si256(red, green), _mm256_or_si256(blue, alpha));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colours + i), packed);
+    }
+
+    shade_particles_scalar(age, i, count, invLifetime, start, end, colours);
+}
@@ -0,0 +1,58 @@
+// Built with SSE4.1 enabled, only called once the CPU has been checked for support
+#include "ParticleKernels.hpp"
+
+#include <smmintrin.h>
+
+void advance_particles_sse41(const ParticleArrays& particles, float dt)
+{
+    const __m128 step = _mm_set1_ps(dt);
+
+    std::size_t i = 0;
+    for (; i + 4 <= particles.count; i += 4) {
+        const __m128 positionX = _mm_loadu_ps(particles.positionX + i);
+        const __m128 positionY = _mm_loadu_ps(particles.positionY + i);
+        const __m128 velocityX = _mm_loadu_ps(particles.velocityX + i);
+        const __m128 velocityY = _mm_loadu_ps(particles.velocityY + i);
+        _mm_storeu_ps(particles.positionX + i, _mm_add_ps(positionX, _mm_mul_ps(velocityX, step)));
+        _mm_storeu_ps(particles.positionY + i, _mm_add_ps(positionY, _mm_mul_ps(velocityY, step)));
+        _mm_storeu_ps(particles.age + i, _mm_add_ps(_mm_loadu_ps(particles.age + i), step));
+    }
+
+    advance_particles_scalar(particles, i, dt);
+}
+
+void shade_particles_sse41(const float* age,
+                           std::size_t count,
+                           float invLifetime,
+                           const sf::Color& start,
+                           const sf::Color& end,
+                           std::uint32_t* colours)
+{
+    const __m128 scale = _mm_set1_ps(invLifetime);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 fixedOne = _mm_set1_ps(256.0f);
+    const __m128i full = _mm_set1_epi32(256);
+    const auto blend = [](std::uint8_t startChannel, std::uint8_t endChannel, __m128i startWeight, __m128i weight) {
+        const __m128i fromStart = _mm_mullo_epi32(_mm_set1_epi32(startChannel), startWeight);
+        const __m128i fromEnd = _mm_mullo_epi32(_mm_set1_epi32(endChannel), weight);
+        return _mm_srai_epi32(_mm_add_epi32(fromStart, fromEnd), 8);
+    };
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // get_colour_weight, min keeps t when it's below one like the scalar compare
+        const __m128 t = _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(age + i), scale), one);
+        const __m128i weight = _mm_cvttps_epi32(_mm_mul_ps(t, fixedOne));
+        const __m128i startWeight = _mm_sub_epi32(full, weight);
+
+        // blend_channel for each channel, packed r, g, b, a from the low byte up
+        const __m128i red = blend(start.r, end.r, startWeight, weight);
+        const __m128i green = _mm_slli_epi32(blend(start.g, end.g, startWeight, weight), 8);
+        const __m128i blue = _mm_slli_epi32(blend(start.b, end.b, startWeight, weight), 16);
+        const __m128i alpha = _mm_slli_epi32(blend(start.a, end.a, startWeight, weight), 24);
+        const __m128i packed = _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colours + i), packed);
+    }
+
+    shade_particles_scalar(age, i, count, invLifetime, start, end, colours);
+}
@@ -0,0 +1,334 @@
+#include "ParticleSystem.hpp"
+#include "Profiler.hpp"
+
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <cassert>
+#include <random>
+
+// Planet Collision Explosion
+constexpr std::size_t PLANET_COLLISION_PARTICLE_COUNT { 100 };
+constexpr auto PLANET_COLLISION_PARTICLE_MAX_SPEED { 200.0f };
+constexpr auto PLANET_COLLISION_PARTICLE_MIN_SPEED { 120.0f };
+constexpr auto PLANET_COLLISION_PARTICLE_LIFETIME { sf::seconds(0.5f) };
+constexpr ParticleLook PLANET_COLLISION_LOOK { { 8.0f, 8.0f }, { 252, 119, 3, 255 }, { 50, 50, 50, 50 } };
+
+// Objective Collected Burst
+constexpr std::size_t OBJECTIVE_COLLECTED_PARTICLE_COUNT { 4000 };
+constexpr auto OBJECTIVE_COLLECTED_PARTICLE_MIN_SPEED { 40.0f };
+constexpr auto OBJECTIVE_COLLECTED_PARTICLE_MAX_SPEED { 260.0f };
+constexpr auto OBJECTIVE_COLLECTED_PARTICLE_LIFETIME { sf::seconds(0.6f) };
+constexpr auto OBJECTIVE_COLLECTED_SPREAD { 180.0f }; // All the way round
+constexpr ParticleLook OBJECTIVE_COLLECTED_LOOK { { 3.0f, 3.0f }, { 255, 223, 94, 255 }, { 255, 140, 0, 0 } };
+
+// Rocket Exhaust
+constexpr auto ROCKET_EXHAUST_PARTICLE_MIN_SPEED { 200.0f };
+constexpr auto ROCKET_EXHAUST_PARTICLE_MAX_SPEED { 250.0f };
+constexpr auto ROCKET_EXHAUST_EMIT_FREQUENCY { sf::microseconds(100) };
+constexpr auto ROCKET_EXHAUST_PARTICLE_LIFETIME { sf::seconds(0.25f) };
+constexpr std::size_t ROCKET_EXHAUST_PARTICLE_COUNT { 5000 };
+constexpr ParticleLook ROCKET_EXHAUST_LOOK { { 4.0f, 4.0f }, { 255, 255, 255, 255 }, { 66, 135, 245, 50 } };
+
+constexpr auto EMIT_SPREAD { 45.0f };
+// Particles per chunk, big enough that a chunk is worth handing to a worker
+constexpr std::size_t CHUNK_SIZE { 2048 };
+constexpr auto EFFECT_COUNT { static_cast<std::size_t>(ParticleSystem::Type::MAX_TYPE) };
+
+// Indexed by ParticleSystem::Type
+constexpr std::array<ParticleSystem::Settings, EFFECT_COUNT> EFFECT_SETTINGS {
+    ParticleSystem::Settings { PLANET_COLLISION_PARTICLE_COUNT,
+                               PLANET_COLLISION_PARTICLE_COUNT,
+                               sf::Time {},
+                               PLANET_COLLISION_PARTICLE_LIFETIME,
+                               PLANET_COLLISION_PARTICLE_MIN_SPEED,
+                               PLANET_COLLISION_PARTICLE_MAX_SPEED,
+                               EMIT_SPREAD,
+                               &write_particle_quads<PLANET_COLLISION_LOOK>,
+                               true },
+    // Room for two bursts, objectives can be collected close together
+    ParticleSystem::Settings { OBJECTIVE_COLLECTED_PARTICLE_COUNT * 2,
+                               OBJECTIVE_COLLECTED_PARTICLE_COUNT,
+                               sf::Time {},
+                               OBJECTIVE_COLLECTED_PARTICLE_LIFETIME,
+                               OBJECTIVE_COLLECTED_PARTICLE_MIN_SPEED,
+                               OBJECTIVE_COLLECTED_PARTICLE_MAX_SPEED,
+                               OBJECTIVE_COLLECTED_SPREAD,
+                               &write_particle_quads<OBJECTIVE_COLLECTED_LOOK>,
+                               false },
+    ParticleSystem::Settings { ROCKET_EXHAUST_PARTICLE_COUNT,
+                               0,
+                               ROCKET_EXHAUST_EMIT_FREQUENCY,
+                               ROCKET_EXHAUST_PARTICLE_LIFETIME,
+                               ROCKET_EXHAUST_PARTICLE_MIN_SPEED,
+                               ROCKET_EXHAUST_PARTICLE_MAX_SPEED,
+                               EMIT_SPREAD,
+                               &write_particle_quads<ROCKET_EXHAUST_LOOK>,
+                               false },
+};
+
+ParticleSystem::ParticleSystem(ThreadPool& pool, std::uint32_t seed, const AssetHolder::AtlasRegion& region)
+    : m_effects { Effect(Type::Planet_Collision, seed, region),
+                  Effect(Type::Objective_Collected, seed, region),
+                  Effect(Type::Rocket_Exhaust, seed, region) }
+    , m_pool(pool)
+    , m_kernel(detect_integrator_kernel())
+{
+}
+
+void ParticleSystem::update(const sf::Time& dt)
+{
+    PROFILE_ZONE("ParticleSystem::update");
+    for (auto& effect : m_effects)
+        effect.update(dt, m_pool, m_kernel);
+}
+
+void ParticleSystem::burst(Type type, const sf::Vector2f& position, const sf::Vector2f& normal)
+{
+    auto& effect = at(type);
+    effect.position = position;
+    effect.normal = normal;
+    effect.burst(m_pool, m_kernel);
+}
+
+void ParticleSystem::start(Type type)
+{
+    auto& effect = at(type);
+    if (!effect.isEmitting) {
+        effect.isEmitting = true;
+        effect.emitTimer = sf::Time::Zero;
+    }
+}
+
+void ParticleSystem::stop(Type type) { at(type).isEmitting = false; }
+
+void ParticleSystem::setEmitter(Type type, const sf::Vector2f& position, const sf::Vector2f& normal)
+{
+    auto& effect = at(type);
+    effect.position = position;
+    effect.normal = normal;
+}
+
+void ParticleSystem::clear()
+{
+    for (auto& effect : m_effects)
+        effect.clear();
+}
+
+auto ParticleSystem::isPlaying(Type type) const -> bool
+{
+    const auto& effect = at(type);
+    return effect.isEmitting || effect.count > 0;
+}
+
+auto ParticleSystem::getParticleCount(Type type) const -> std::size_t { return at(type).count; }
+
+auto ParticleSystem::getEffect(Type type) const -> const sf::Drawable& { return at(type); }
+
+auto ParticleSystem::getVertices(Type type) const -> const sf::Vertex* { return at(type).getVertices(); }
+
+auto ParticleSystem::at(Type type) -> Effect&
+{
+    assert(type < Type::MAX_TYPE);
+    return m_effects[static_cast<std::size_t>(type)];
+}
+
+auto ParticleSystem::at(Type type) const -> const Effect&
+{
+    assert(type < Type::MAX_TYPE);
+    return m_effects[static_cast<std::size_t>(type)];
+}
+
+ParticleSystem::Effect::Effect(Type type, std::uint32_t seed, const AssetHolder::AtlasRegion& region)
+    : settings(EFFECT_SETTINGS[static_cast<std::size_t>(type)])
+    , m_type(type)
+    , m_seed(seed)
+    , m_texture(region.texture)
+    , m_positionX(settings.capacity)
+    , m_positionY(settings.capacity)
+    , m_velocityX(settings.capacity)
+    , m_velocityY(settings.capacity)
+    , m_age(settings.capacity)
+    , m_vertices(settings.capacity * 6)
+    , m_vertexBuffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream)
+{
+    for (std::size_t first = 0; first < settings.capacity; first += CHUNK_SIZE) {
+        Chunk chunk;
+        chunk.first = first;
+        chunk.capacity = std::min(CHUNK_SIZE, settings.capacity - first);
+        m_chunks.push_back(chunk);
+    }
+
+    // Without vertex buffer support the vertices are drawn straight from memory.
+    // Checking for support creates a graphics context, so a system without an
+    // image, which benchmarks & tests use headless, never asks.
+    m_hasVertexBuffer = !m_vertices.empty() && m_texture != nullptr && sf::VertexBuffer::isAvailable()
+        && m_vertexBuffer.create(m_vertices.size());
+
+    // Every slot shows the whole image, so texture coordinates never change.
+    // Untextured quads sample the middle of the image's first texel.
+    const auto texTopLeft = sf::Vector2f(region.rect.getPosition());
+    const auto texBottomRight = settings.isTextured ? texTopLeft + sf::Vector2f(region.rect.getSize()) : texTopLeft;
+    const auto texOffset = settings.isTextured ? sf::Vector2f {} : sf::Vector2f { 0.5f, 0.5f };
+    for (std::size_t i = 0; i < m_vertices.size(); i += 6) {
+        sf::Vertex* v = &m_vertices[i];
+        v[0].texCoords = texTopLeft + texOffset;
+        v[1].texCoords = sf::Vector2f { texBottomRight.x, texTopLeft.y } + texOffset;
+        v[2].texCoords = texBottomRight + texOffset;
+        v[3].texCoords = texBottomRight + texOffset;
+        v[4].texCoords = sf::Vector2f { texTopLeft.x, texBottomRight.y } + texOffset;
+        v[5].texCoords = texTopLeft + texOffset;
+    }
+}
+
+void ParticleSystem::Effect::update(const sf::Time& dt, ThreadPool& pool, ParticleKernel kernel)
+{
+    if (count > 0) {
+        pool.parallelFor(m_chunks.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i)
+                advanceChunk(m_chunks[i], dt.asSeconds(), kernel);
+        });
+    }
+
+    std::size_t emitCount = 0;
+    if (isEmitting && settings.emitInterval > sf::Time::Zero) {
+        emitTimer += dt;
+        emitCount = static_cast<std::size_t>(emitTimer.asMicroseconds() / settings.emitInterval.asMicroseconds());
+        emitTimer = emitTimer % settings.emitInterval;
+    }
+    emitAndWrite(emitCount, pool, kernel);
+}
+
+void ParticleSystem::Effect::burst(ThreadPool& pool, ParticleKernel kernel)
+{
+    emitAndWrite(settings.burstCount, pool, kernel);
+}
+
+void ParticleSystem::Effect::clear()
+{
+    isEmitting = false;
+    emitTimer = sf::Time::Zero;
+    count = 0;
+    for (auto& chunk : m_chunks)
+        chunk.count = 0;
+}
+
+auto ParticleSystem::Effect::getVertices() const -> const sf::Vertex* { return m_vertices.data(); }
+
+void ParticleSystem::Effect::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
+    if (count == 0)
+        return;
+
+    auto statesCopy = states;
+    statesCopy.texture = m_texture;
+    if (m_hasVertexBuffer)
+        target.draw(m_vertexBuffer, 0, count * 6, statesCopy);
+    else
+        target.draw(m_vertices.data(), count * 6, sf::PrimitiveType::Triangles, statesCopy);
+}
+
+void ParticleSystem::Effect::upload(std::size_t begin, std::size_t end)
+{
+    if (m_hasVertexBuffer && end > begin) {
+        [[maybe_unused]] const bool isUpdated = m_vertexBuffer.update(
+            &m_vertices[begin * 6], (end - begin) * 6, static_cast<unsigned int>(begin * 6));
+        assert(isUpdated);
+    }
+}
+
+void ParticleSystem::Effect::advanceChunk(Chunk& chunk, float dt, ParticleKernel kernel)
+{
+    advance_particles(kernel, getArrays(chunk), dt);
+
+    const auto lifetime = settings.lifetime.asSeconds();
+    for (auto i = chunk.first; i < chunk.first + chunk.count;) {
+        if (m_age[i] < lifetime) {
+            ++i;
+            continue;
+        }
+
+        // Swap the chunk's last live particle into the dead one's slot
+        const auto last = chunk.first + --chunk.count;
+        m_positionX[i] = m_positionX[last];
+        m_positionY[i] = m_positionY[last];
+        m_velocityX[i] = m_velocityX[last];
+        m_velocityY[i] = m_velocityY[last];
+        m_age[i] = m_age[last];
+    }
+}
+
+void ParticleSystem::Effect::emitChunk(Chunk& chunk, std::size_t chunkIndex, std::uint64_t emission)
+{
+    if (chunk.emitCount == 0)
+        return;
+
+    std::seed_seq seeds { m_seed,
+                          static_cast<std::uint32_t>(m_type),
+                          static_cast<std::uint32_t>(emission),
+                          static_cast<std::uint32_t>(emission >> 32),
+                          static_cast<std::uint32_t>(chunkIndex) };
+    std::default_random_engine randomEngine(seeds);
+
+    const auto normalAngle = normal != sf::Vector2f {} ? normal.angle().asDegrees() : 0.0f;
+    std::uniform_real_distribution<float> angleDist(normalAngle - settings.spread, normalAngle + settings.spread);
+    std::uniform_real_distribution<float> speedDist(settings.minSpeed, settings.maxSpeed);
+
+    const auto end = chunk.first + chunk.count + chunk.emitCount;
+    for (auto i = chunk.first + chunk.count; i < end; ++i) {
+        const sf::Vector2f velocity { speedDist(randomEngine), sf::degrees(angleDist(randomEngine)) };
+        m_positionX[i] = position.x;
+        m_positionY[i] = position.y;
+        m_velocityX[i] = velocity.x;
+        m_velocityY[i] = velocity.y;
+        m_age[i] = 0.0f;
+    }
+    chunk.count += chunk.emitCount;
+    chunk.emitCount = 0;
+}
+
+void ParticleSystem::Effect::writeChunk(const Chunk& chunk, ParticleKernel kernel)
+{
+    if (chunk.count > 0) {
+        settings.writeQuads(kernel,
+                            getArrays(chunk),
+                            0,
+                            chunk.count,
+                            1.0f / settings.lifetime.asSeconds(),
+                            &m_vertices[chunk.quadOffset * 6]);
+    }
+}
+
+void ParticleSystem::Effect::emitAndWrite(std::size_t emitCount, ThreadPool& pool, ParticleKernel kernel)
+{
+    // Chunks are filled in order & particles past the pool's capacity are
+    // dropped. Each chunk's quads follow the previous chunk's, so the live
+    // quads stay contiguous for the upload & draw.
+    count = 0;
+    for (auto& chunk : m_chunks) {
+        chunk.emitCount = std::min(emitCount, chunk.capacity - chunk.count);
+        emitCount -= chunk.emitCount;
+        chunk.quadOffset = count;
+        count += chunk.count + chunk.emitCount;
+    }
+
+    const auto emission = m_emissionCount++;
+    if (count > 0) {
+        pool.parallelFor(m_chunks.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                emitChunk(m_chunks[i], i, emission);
+                writeChunk(m_chunks[i], kernel);
+            }
+        });
+    }
+    upload(0, count);
+}
+
+auto ParticleSystem::Effect::getArrays(const Chunk& chunk) -> ParticleArrays
+{
+    return { &m_positionX[chunk.first],
+             &m_positionY[chunk.first],
+             &m_velocityX[chunk.first],
+             &m_velocityY[chunk.first],
+             &m_age[chunk.first],
+             chunk.count };
+}
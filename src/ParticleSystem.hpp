@@ -0,0 +1,134 @@
+#pragma once
+
+#include "AssetHolder.hpp"
+#include "ParticleKernels.hpp"
+#include "ThreadPool.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Every particle in the play scene. Each effect type owns one pool that is
+// allocated up front, particles are stored as structure of arrays. Pools are
+// split into fixed size chunks that the thread pool updates concurrently,
+// each chunk keeps its live particles packed at its front so updates only
+// touch live particles. Chunks write their quads into disjoint ranges of
+// one vertex array, packed one after another, so each effect uploads them
+// to a streamed vertex buffer in one go & draws them with a single call.
+// Effects are started & stopped rather than created & destroyed, nothing
+// allocates once the system is constructed. Effects that fit in one chunk
+// are updated on the calling thread.
+//
+// Random numbers come from the seed, the effect, how many emissions the
+// effect has made & the chunk, never from which thread ran what, so the
+// same seed & calls give the same particles every run.
+class ParticleSystem {
+public:
+    enum class Type {
+        Planet_Collision,
+        Objective_Collected,
+        Rocket_Exhaust,
+        MAX_TYPE
+    };
+
+    // Region is the particle image in the sprite atlas. Without a texture
+    // nothing touches the graphics context, for running headless.
+    ParticleSystem(ThreadPool& pool, std::uint32_t seed, const AssetHolder::AtlasRegion& region);
+
+    void update(const sf::Time& dt);
+
+    // Emits the effect's whole burst at once
+    void burst(Type type, const sf::Vector2f& position, const sf::Vector2f& normal);
+    // Emits continuously from the emitter until stopped, particles already
+    // emitted play out after a stop
+    void start(Type type);
+    void stop(Type type);
+    void setEmitter(Type type, const sf::Vector2f& position, const sf::Vector2f& normal);
+    // Stops every effect & kills all particles
+    void clear();
+
+    // Emitting, or with particles still alive
+    auto isPlaying(Type type) const -> bool;
+    auto getParticleCount(Type type) const -> std::size_t;
+    auto getEffect(Type type) const -> const sf::Drawable&;
+    // Six per live particle, as last written by an update or burst
+    auto getVertices(Type type) const -> const sf::Vertex*;
+
+    struct Settings {
+        std::size_t capacity { 0 };
+        std::size_t burstCount { 0 };
+        sf::Time emitInterval; // Between particles while emitting continuously
+        sf::Time lifetime;
+        float minSpeed { 0.0f };
+        float maxSpeed { 0.0f };
+        float spread { 0.0f }; // Degrees either side of the emitter normal
+        // write_particle_quads instantiated for the effect's look
+        ParticleQuadWriter writeQuads { nullptr };
+        bool isTextured { false }; // Otherwise the whole quad samples the image's first texel
+    };
+
+private:
+    class Effect : public sf::Drawable {
+    public:
+        Effect(Type type, std::uint32_t seed, const AssetHolder::AtlasRegion& region);
+
+        void update(const sf::Time& dt, ThreadPool& pool, ParticleKernel kernel);
+        void burst(ThreadPool& pool, ParticleKernel kernel);
+        void clear();
+        auto getVertices() const -> const sf::Vertex*;
+
+        const Settings& settings;
+        sf::Vector2f position;
+        sf::Vector2f normal;
+        sf::Time emitTimer;
+        bool isEmitting { false };
+        std::size_t count { 0 }; // Live particles across every chunk
+
+    protected:
+        virtual void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
+
+    private:
+        struct Chunk {
+            std::size_t first { 0 }; // Pool slot of the chunk's first particle
+            std::size_t capacity { 0 };
+            std::size_t count { 0 }; // Live particles, packed at the front of the chunk
+            std::size_t emitCount { 0 }; // Handed out by the current emission
+            std::size_t quadOffset { 0 }; // First quad the chunk writes
+        };
+
+        void advanceChunk(Chunk& chunk, float dt, ParticleKernel kernel);
+        void emitChunk(Chunk& chunk, std::size_t chunkIndex, std::uint64_t emission);
+        void writeChunk(const Chunk& chunk, ParticleKernel kernel);
+        // Shares emitCount out between the chunks, emits & rewrites every quad
+        void emitAndWrite(std::size_t emitCount, ThreadPool& pool, ParticleKernel kernel);
+        void upload(std::size_t begin, std::size_t end);
+        auto getArrays(const Chunk& chunk) -> ParticleArrays;
+
+        Type m_type;
+        std::uint32_t m_seed;
+        std::uint64_t m_emissionCount { 0 };
+        const sf::Texture* m_texture;
+        std::vector<Chunk> m_chunks;
+        std::vector<float> m_positionX;
+        std::vector<float> m_positionY;
+        std::vector<float> m_velocityX;
+        std::vector<float> m_velocityY;
+        std::vector<float> m_age; // Seconds
+        std::vector<sf::Vertex> m_vertices; // Six per particle
+        sf::VertexBuffer m_vertexBuffer;
+        bool m_hasVertexBuffer { false };
+    };
+
+    auto at(Type type) -> Effect&;
+    auto at(Type type) const -> const Effect&;
+
+    std::array<Effect, static_cast<std::size_t>(Type::MAX_TYPE)> m_effects;
+    ThreadPool& m_pool;
+    ParticleKernel m_kernel;
+};
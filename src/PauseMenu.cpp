@@ -1,16 +1,17 @@
 #include "PauseMenu.hpp"
 #include "AssetHolder.hpp"
+#include "FrameArena.hpp"
 #include "GameLevel.hpp"
 #include "GameplayBlackboard.hpp"
 #include "InputHandler.hpp"
 #include "SFUtility.hpp"
 
 #include <cassert>
-#include <spdlog/fmt/fmt.h>
 
 constexpr auto DEFAULT_MENU_TITLE = "Paused";
 constexpr auto OPTIONS_MENU_TITLE = "Options";
 constexpr auto LEVELSUMMARY_MENU_TITLE = "Level Complete!";
+constexpr auto LOADING_MENU_TITLE = "Loading...";
 
 PauseMenu::PauseMenu(sf::RenderWindow& window, SoundCentral& soundCentral, GameLevel& level)
     : m_window(window)
@@ -54,6 +55,8 @@ void PauseMenu::update(const sf::Time& dt)
     case PauseMenu::SubMenuStage::LevelSummary:
         updateLevelSummary();
         break;
+    case PauseMenu::SubMenuStage::Loading:
+        break;
     }
 }
 
@@ -72,6 +75,9 @@ void PauseMenu::setSubMenuStage(PauseMenu::SubMenuStage stage)
     case SubMenuStage::LevelSummary:
         m_uiMenuTitle.setString(LEVELSUMMARY_MENU_TITLE);
         break;
+    case SubMenuStage::Loading:
+        m_uiMenuTitle.setString(LOADING_MENU_TITLE);
+        break;
     default:
         assert(false);
         break;
@@ -111,6 +117,8 @@ void PauseMenu::draw(sf::RenderTarget& target, const sf::RenderStates& states) c
         target.draw(m_uiAttemptsIndicator, states);
         target.draw(m_uiContinueLevelButton, states);
         break;
+    case PauseMenu::SubMenuStage::Loading:
+        break;
     default:
         assert(false);
         break;
@@ -119,7 +127,7 @@ void PauseMenu::draw(sf::RenderTarget& target, const sf::RenderStates& states) c
 
 void PauseMenu::setupUIText()
 {
-    auto const font { AssetHolder::get().getFont("bin/fonts/VCR_OSD_MONO_1.001.ttf") };
+    auto const font { AssetHolder::get().getFont(AssetId::Fonts_VCR_OSD_MONO_1_001) };
 
     setupTextProperty(m_uiMenuTitle, font, DEFAULT_MENU_TITLE, bb::TITLE_FONT_SIZE);
     m_uiMenuTitle.setStyle(sf::Text::Style::Bold);
@@ -217,7 +225,7 @@ void PauseMenu::updateOptions(const sf::Time& dt)
 
 void PauseMenu::updateLevelSummary()
 {
-    m_uiAttemptsIndicator.setString(fmt::format("Attempts : {}", m_level->getAttemptTotal()));
+    m_uiAttemptsIndicator.setString(frame_format("Attempts : {}", m_level->getAttemptTotal()).c_str());
     if (updateHoveredStatus(m_uiContinueLevelButton)) {
         if (InputHandler::get().leftClickPressed()) {
             m_returnToPlaying = true;
@@ -265,7 +273,7 @@ void PauseMenu::updateVolumeUIPositions()
     const auto volumeButtonRadius = m_uiUpVolume.getRadius();
     const auto masterVolume = m_soundCentral->getMasterVolume();
 
-    m_uiMasterVolumeIndicator.setString(fmt::format("{}%", masterVolume));
+    m_uiMasterVolumeIndicator.setString(frame_format("{}%", masterVolume).c_str());
     CentreTextOrigin(m_uiMasterVolumeIndicator);
     m_uiMasterVolumeIndicator.setPosition(getSpacedLocation(m_uiMasterVolumeTitle));
 
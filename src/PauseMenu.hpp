@@ -14,7 +14,8 @@ class GameLevel;
 
 class PauseMenu : public sf::Drawable {
 public:
-    enum class SubMenuStage { Default = 0, Options, LevelSummary };
+    // Loading is shown while the next level finishes loading, it has no buttons
+    enum class SubMenuStage { Default = 0, Options, LevelSummary, Loading };
 
     PauseMenu(sf::RenderWindow& window, SoundCentral& soundCentral, GameLevel& level);
 
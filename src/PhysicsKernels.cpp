@@ -0,0 +1,128 @@
+#include "PhysicsKernels.hpp"
+
+#include <cassert>
+
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS)
+namespace {
+bool cpu_supports_sse41()
+{
+#if defined(_MSC_VER)
+    int info[4] {};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+bool cpu_supports_avx2()
+{
+#if defined(_MSC_VER)
+    int info[4] {};
+    __cpuid(info, 1);
+    const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    const bool hasAvx = (info[2] & (1 << 28)) != 0;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && hasAvx && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+}
+#endif
+
+auto detect_integrator_kernel() -> IntegratorKernel
+{
+    if (is_integrator_kernel_supported(IntegratorKernel::AVX2))
+        return IntegratorKernel::AVX2;
+    if (is_integrator_kernel_supported(IntegratorKernel::SSE41))
+        return IntegratorKernel::SSE41;
+    return IntegratorKernel::Scalar;
+}
+
+auto is_integrator_kernel_supported(IntegratorKernel kernel) -> bool
+{
+    switch (kernel) {
+    case IntegratorKernel::Scalar:
+        return true;
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS)
+    case IntegratorKernel::SSE41:
+        return cpu_supports_sse41();
+    case IntegratorKernel::AVX2:
+        return cpu_supports_avx2();
+#endif
+    default:
+        return false;
+    }
+}
+
+auto get_integrator_kernel_name(IntegratorKernel kernel) -> const char*
+{
+    switch (kernel) {
+    case IntegratorKernel::Scalar:
+        return "Scalar";
+    case IntegratorKernel::SSE41:
+        return "SSE4.1";
+    case IntegratorKernel::AVX2:
+        return "AVX2";
+    default:
+        assert(false);
+        return "Unknown";
+    }
+}
+
+void integrate_bodies(IntegratorKernel kernel, const BodyArrays& bodies, float timeStep)
+{
+    assert(is_integrator_kernel_supported(kernel));
+    switch (kernel) {
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS)
+    case IntegratorKernel::SSE41:
+        integrate_bodies_sse41(bodies, timeStep);
+        break;
+    case IntegratorKernel::AVX2:
+        integrate_bodies_avx2(bodies, timeStep);
+        break;
+#endif
+    default:
+        integrate_bodies_scalar(bodies, 0, timeStep);
+        break;
+    }
+}
+
+void integrate_bodies_scalar(const BodyArrays& bodies, std::size_t first, float timeStep)
+{
+    for (std::size_t i = first; i < bodies.count; ++i) {
+        // Immovable!
+        if (bodies.invMass[i] == 0.0f || !bodies.isActive[i]) {
+            continue;
+        }
+
+        BodyState body { { bodies.positionX[i], bodies.positionY[i] },
+                         bodies.rotation[i],
+                         { bodies.velocityX[i], bodies.velocityY[i] },
+                         bodies.angularVelocity[i] };
+
+        integrate_body(body,
+                       { bodies.forceX[i], bodies.forceY[i] },
+                       bodies.torque[i],
+                       bodies.invMass[i],
+                       bodies.invInertia[i],
+                       timeStep);
+
+        bodies.positionX[i] = body.position.x;
+        bodies.positionY[i] = body.position.y;
+        bodies.rotation[i] = body.rotation;
+        bodies.velocityX[i] = body.linearVelocity.x;
+        bodies.velocityY[i] = body.linearVelocity.y;
+        bodies.angularVelocity[i] = body.angularVelocity;
+
+        // Clear force & torque
+        bodies.forceX[i] = bodies.forceY[i] = 0.0f;
+        bodies.torque[i] = 0.0f;
+    }
+}
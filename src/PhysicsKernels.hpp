@@ -0,0 +1,86 @@
+#pragma once
+
+#include "GameplayBlackboard.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Views into PhysicsWorld's body arrays, every array holds count elements
+struct BodyArrays {
+    float* positionX { nullptr };
+    float* positionY { nullptr };
+    float* rotation { nullptr }; // Degrees
+    float* velocityX { nullptr };
+    float* velocityY { nullptr };
+    float* angularVelocity { nullptr };
+    float* forceX { nullptr };
+    float* forceY { nullptr };
+    float* torque { nullptr };
+    const float* invMass { nullptr };
+    const float* invInertia { nullptr };
+    const std::uint8_t* isActive { nullptr };
+    std::size_t count { 0 };
+};
+
+struct BodyState {
+    sf::Vector2f position;
+    float rotation { 0.0f }; // Degrees
+    sf::Vector2f linearVelocity;
+    float angularVelocity { 0.0f };
+};
+
+enum class IntegratorKernel { Scalar = 0, SSE41, AVX2 };
+
+inline float wrap_degrees(float degrees)
+{
+    const float value = degrees - static_cast<float>(static_cast<std::int32_t>(degrees / 360.0f)) * 360.0f;
+    return value >= 0.0f ? value : value + 360.0f;
+}
+
+// The integration rules for a single body. Every kernel performs exactly these
+// operations in this order so they all produce bit identical results.
+inline void integrate_body(BodyState& body,
+                           const sf::Vector2f& force,
+                           float torque,
+                           float invMass,
+                           float invInertia,
+                           float timeStep)
+{
+    // Linear
+    auto velocity = body.linearVelocity;
+    velocity.x += force.x * invMass * timeStep;
+    velocity.y += force.y * invMass * timeStep;
+
+    const float length = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    const float speed = bb::MAX_SPEED < length ? bb::MAX_SPEED : length;
+    if (velocity.x != 0.0f || velocity.y != 0.0f) {
+        velocity.x = velocity.x / length * speed;
+        velocity.y = velocity.y / length * speed;
+    }
+
+    body.linearVelocity = velocity;
+    body.position.x += velocity.x * timeStep;
+    body.position.y += velocity.y * timeStep;
+
+    // Oriented
+    const float angularVelocity = body.angularVelocity + torque * invInertia * timeStep;
+    body.angularVelocity = bb::MAX_ANGULAR_SPEED < angularVelocity ? bb::MAX_ANGULAR_SPEED : angularVelocity;
+    body.rotation = wrap_degrees(body.rotation + body.angularVelocity * timeStep * bb::RADIANS_TO_DEGREES);
+}
+
+// Best kernel the running CPU supports
+auto detect_integrator_kernel() -> IntegratorKernel;
+auto is_integrator_kernel_supported(IntegratorKernel kernel) -> bool;
+auto get_integrator_kernel_name(IntegratorKernel kernel) -> const char*;
+
+// Integrates every active body with a non zero mass, then clears their forces
+void integrate_bodies(IntegratorKernel kernel, const BodyArrays& bodies, float timeStep);
+
+void integrate_bodies_scalar(const BodyArrays& bodies, std::size_t first, float timeStep);
+#if defined(IMPOSSIBLE_ROCKET_X86_KERNELS)
+void integrate_bodies_sse41(const BodyArrays& bodies, float timeStep);
+void integrate_bodies_avx2(const BodyArrays& bodies, float timeStep);
+#endif
@@ -0,0 +1,78 @@
+// Built with AVX2 enabled, only called once the CPU has been checked for support
+#include "PhysicsKernels.hpp"
+
+#include <immintrin.h>
+
+void integrate_bodies_avx2(const BodyArrays& bodies, float timeStep)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 dt = _mm256_set1_ps(timeStep);
+    const __m256 maxSpeed = _mm256_set1_ps(bb::MAX_SPEED);
+    const __m256 maxAngularSpeed = _mm256_set1_ps(bb::MAX_ANGULAR_SPEED);
+    const __m256 radiansToDegrees = _mm256_set1_ps(bb::RADIANS_TO_DEGREES);
+    const __m256 fullTurn = _mm256_set1_ps(360.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= bodies.count; i += 8) {
+        const auto activeBytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(bodies.isActive + i));
+        const __m256i activeFlags = _mm256_cvtepu8_epi32(activeBytes);
+        const __m256 invMass = _mm256_loadu_ps(bodies.invMass + i);
+
+        // Immovable!
+        const __m256 isInactive = _mm256_castsi256_ps(_mm256_cmpeq_epi32(activeFlags, _mm256_setzero_si256()));
+        const __m256 active = _mm256_andnot_ps(isInactive, _mm256_cmp_ps(invMass, zero, _CMP_NEQ_UQ));
+        if (_mm256_movemask_ps(active) == 0)
+            continue;
+
+        // Linear
+        const __m256 forceX = _mm256_loadu_ps(bodies.forceX + i);
+        const __m256 forceY = _mm256_loadu_ps(bodies.forceY + i);
+        const __m256 oldVelocityX = _mm256_loadu_ps(bodies.velocityX + i);
+        const __m256 oldVelocityY = _mm256_loadu_ps(bodies.velocityY + i);
+        __m256 velocityX = _mm256_add_ps(oldVelocityX, _mm256_mul_ps(_mm256_mul_ps(forceX, invMass), dt));
+        __m256 velocityY = _mm256_add_ps(oldVelocityY, _mm256_mul_ps(_mm256_mul_ps(forceY, invMass), dt));
+
+        const __m256 length = _mm256_sqrt_ps(
+            _mm256_add_ps(_mm256_mul_ps(velocityX, velocityX), _mm256_mul_ps(velocityY, velocityY)));
+        const __m256 speed = _mm256_min_ps(maxSpeed, length);
+        const __m256 isMoving = _mm256_or_ps(_mm256_cmp_ps(velocityX, zero, _CMP_NEQ_UQ),
+                                             _mm256_cmp_ps(velocityY, zero, _CMP_NEQ_UQ));
+        velocityX = _mm256_blendv_ps(velocityX, _mm256_mul_ps(_mm256_div_ps(velocityX, length), speed), isMoving);
+        velocityY = _mm256_blendv_ps(velocityY, _mm256_mul_ps(_mm256_div_ps(velocityY, length), speed), isMoving);
+
+        const __m256 oldPositionX = _mm256_loadu_ps(bodies.positionX + i);
+        const __m256 oldPositionY = _mm256_loadu_ps(bodies.positionY + i);
+        const __m256 positionX = _mm256_add_ps(oldPositionX, _mm256_mul_ps(velocityX, dt));
+        const __m256 positionY = _mm256_add_ps(oldPositionY, _mm256_mul_ps(velocityY, dt));
+
+        // Oriented
+        const __m256 torque = _mm256_loadu_ps(bodies.torque + i);
+        const __m256 oldAngularVelocity = _mm256_loadu_ps(bodies.angularVelocity + i);
+        __m256 angularVelocity = _mm256_add_ps(
+            oldAngularVelocity, _mm256_mul_ps(_mm256_mul_ps(torque, _mm256_loadu_ps(bodies.invInertia + i)), dt));
+        angularVelocity = _mm256_min_ps(maxAngularSpeed, angularVelocity);
+
+        const __m256 oldRotation = _mm256_loadu_ps(bodies.rotation + i);
+        const __m256 degrees
+            = _mm256_add_ps(oldRotation, _mm256_mul_ps(_mm256_mul_ps(angularVelocity, dt), radiansToDegrees));
+        const __m256 turns = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_div_ps(degrees, fullTurn)));
+        __m256 rotation = _mm256_sub_ps(degrees, _mm256_mul_ps(turns, fullTurn));
+        const __m256 isNegative = _mm256_cmp_ps(rotation, zero, _CMP_LT_OQ);
+        rotation = _mm256_blendv_ps(rotation, _mm256_add_ps(rotation, fullTurn), isNegative);
+
+        // Only active lanes are written back, inactive bodies keep their forces
+        _mm256_storeu_ps(bodies.velocityX + i, _mm256_blendv_ps(oldVelocityX, velocityX, active));
+        _mm256_storeu_ps(bodies.velocityY + i, _mm256_blendv_ps(oldVelocityY, velocityY, active));
+        _mm256_storeu_ps(bodies.positionX + i, _mm256_blendv_ps(oldPositionX, positionX, active));
+        _mm256_storeu_ps(bodies.positionY + i, _mm256_blendv_ps(oldPositionY, positionY, active));
+        _mm256_storeu_ps(bodies.angularVelocity + i, _mm256_blendv_ps(oldAngularVelocity, angularVelocity, active));
+        _mm256_storeu_ps(bodies.rotation + i, _mm256_blendv_ps(oldRotation, rotation, active));
+
+        // Clear force & torque
+        _mm256_storeu_ps(bodies.forceX + i, _mm256_blendv_ps(forceX, zero, active));
+        _mm256_storeu_ps(bodies.forceY + i, _mm256_blendv_ps(forceY, zero, active));
+        _mm256_storeu_ps(bodies.torque + i, _mm256_blendv_ps(torque, zero, active));
+    }
+
+    integrate_bodies_scalar(bodies, i, timeStep);
+}
@@ -0,0 +1,78 @@
+// Built with SSE4.1 enabled, only called once the CPU has been checked for support
+#include "PhysicsKernels.hpp"
+
+#include <cstring>
+#include <smmintrin.h>
+
+void integrate_bodies_sse41(const BodyArrays& bodies, float timeStep)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 dt = _mm_set1_ps(timeStep);
+    const __m128 maxSpeed = _mm_set1_ps(bb::MAX_SPEED);
+    const __m128 maxAngularSpeed = _mm_set1_ps(bb::MAX_ANGULAR_SPEED);
+    const __m128 radiansToDegrees = _mm_set1_ps(bb::RADIANS_TO_DEGREES);
+    const __m128 fullTurn = _mm_set1_ps(360.0f);
+
+    std::size_t i = 0;
+    for (; i + 4 <= bodies.count; i += 4) {
+        std::int32_t activeBytes;
+        std::memcpy(&activeBytes, bodies.isActive + i, sizeof(activeBytes));
+        const __m128i activeFlags = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(activeBytes));
+        const __m128 invMass = _mm_loadu_ps(bodies.invMass + i);
+
+        // Immovable!
+        const __m128 isInactive = _mm_castsi128_ps(_mm_cmpeq_epi32(activeFlags, _mm_setzero_si128()));
+        const __m128 active = _mm_andnot_ps(isInactive, _mm_cmpneq_ps(invMass, zero));
+        if (_mm_movemask_ps(active) == 0)
+            continue;
+
+        // Linear
+        const __m128 forceX = _mm_loadu_ps(bodies.forceX + i);
+        const __m128 forceY = _mm_loadu_ps(bodies.forceY + i);
+        const __m128 oldVelocityX = _mm_loadu_ps(bodies.velocityX + i);
+        const __m128 oldVelocityY = _mm_loadu_ps(bodies.velocityY + i);
+        __m128 velocityX = _mm_add_ps(oldVelocityX, _mm_mul_ps(_mm_mul_ps(forceX, invMass), dt));
+        __m128 velocityY = _mm_add_ps(oldVelocityY, _mm_mul_ps(_mm_mul_ps(forceY, invMass), dt));
+
+        const __m128 length
+            = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY)));
+        const __m128 speed = _mm_min_ps(maxSpeed, length);
+        const __m128 isMoving = _mm_or_ps(_mm_cmpneq_ps(velocityX, zero), _mm_cmpneq_ps(velocityY, zero));
+        velocityX = _mm_blendv_ps(velocityX, _mm_mul_ps(_mm_div_ps(velocityX, length), speed), isMoving);
+        velocityY = _mm_blendv_ps(velocityY, _mm_mul_ps(_mm_div_ps(velocityY, length), speed), isMoving);
+
+        const __m128 oldPositionX = _mm_loadu_ps(bodies.positionX + i);
+        const __m128 oldPositionY = _mm_loadu_ps(bodies.positionY + i);
+        const __m128 positionX = _mm_add_ps(oldPositionX, _mm_mul_ps(velocityX, dt));
+        const __m128 positionY = _mm_add_ps(oldPositionY, _mm_mul_ps(velocityY, dt));
+
+        // Oriented
+        const __m128 torque = _mm_loadu_ps(bodies.torque + i);
+        const __m128 oldAngularVelocity = _mm_loadu_ps(bodies.angularVelocity + i);
+        __m128 angularVelocity = _mm_add_ps(
+            oldAngularVelocity, _mm_mul_ps(_mm_mul_ps(torque, _mm_loadu_ps(bodies.invInertia + i)), dt));
+        angularVelocity = _mm_min_ps(maxAngularSpeed, angularVelocity);
+
+        const __m128 oldRotation = _mm_loadu_ps(bodies.rotation + i);
+        const __m128 degrees
+            = _mm_add_ps(oldRotation, _mm_mul_ps(_mm_mul_ps(angularVelocity, dt), radiansToDegrees));
+        const __m128 turns = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(degrees, fullTurn)));
+        __m128 rotation = _mm_sub_ps(degrees, _mm_mul_ps(turns, fullTurn));
+        rotation = _mm_blendv_ps(rotation, _mm_add_ps(rotation, fullTurn), _mm_cmplt_ps(rotation, zero));
+
+        // Only active lanes are written back, inactive bodies keep their forces
+        _mm_storeu_ps(bodies.velocityX + i, _mm_blendv_ps(oldVelocityX, velocityX, active));
+        _mm_storeu_ps(bodies.velocityY + i, _mm_blendv_ps(oldVelocityY, velocityY, active));
+        _mm_storeu_ps(bodies.positionX + i, _mm_blendv_ps(oldPositionX, positionX, active));
+        _mm_storeu_ps(bodies.positionY + i, _mm_blendv_ps(oldPositionY, positionY, active));
+        _mm_storeu_ps(bodies.angularVelocity + i, _mm_blendv_ps(oldAngularVelocity, angularVelocity, active));
+        _mm_storeu_ps(bodies.rotation + i, _mm_blendv_ps(oldRotation, rotation, active));
+
+        // Clear force & torque
+        _mm_storeu_ps(bodies.forceX + i, _mm_blendv_ps(forceX, zero, active));
+        _mm_storeu_ps(bodies.forceY + i, _mm_blendv_ps(forceY, zero, active));
+        _mm_storeu_ps(bodies.torque + i, _mm_blendv_ps(torque, zero, active));
+    }
+
+    integrate_bodies_scalar(bodies, i, timeStep);
+}
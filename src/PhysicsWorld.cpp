@@ -1,56 +1,219 @@
 #include "PhysicsWorld.hpp"
+#include "Profiler.hpp"
 
-constexpr auto MAX_SPEED { 310.0f };
-constexpr auto MAX_ANGULAR_SPEED { 15.0f };
+#include <algorithm>
+#include <cassert>
 
-PhysicsWorld::PhysicsWorld() { }
+PhysicsWorld::PhysicsWorld()
+    : m_integratorKernel(detect_integrator_kernel())
+{
+}
 
-void PhysicsWorld::step(const sf::Time& timeStep, const sf::Time& dt)
+auto PhysicsWorld::step(const sf::Time& timeStep, const sf::Time& dt, const TickCallback& onTick) -> std::uint32_t
 {
+    PROFILE_ZONE("PhysicsWorld::step");
+    assert(timeStep > sf::Time::Zero);
     m_accumulator += dt;
-    while (m_accumulator >= timeStep) {
+
+    // Steps past the max are dropped along with their time
+    const auto stepsDue = m_accumulator.asMicroseconds() / timeStep.asMicroseconds();
+    const auto subSteps = static_cast<std::uint32_t>(std::min<std::int64_t>(stepsDue, m_maxSubSteps));
+    m_accumulator = m_accumulator % timeStep;
+
+    for (std::uint32_t i = 0; i < subSteps; ++i) {
+        // Interpolation only blends across the last step, so that's the only
+        // one worth snapshotting
+        if (i + 1 == subSteps) {
+            m_previousPositionX = m_positionX;
+            m_previousPositionY = m_positionY;
+            m_previousRotation = m_rotation;
+        }
+
         integrate(timeStep);
-        m_accumulator -= dt;
+        if (onTick)
+            onTick(timeStep);
     }
+
+    m_interpolationAlpha = m_accumulator / timeStep;
+    return subSteps;
 }
 
-std::shared_ptr<PhysicsBody> PhysicsWorld::addBody()
+void PhysicsWorld::setMaxSubSteps(std::uint32_t maxSubSteps)
 {
-    auto body = std::make_shared<PhysicsBody>();
-    m_bodies.push_back(body);
+    assert(maxSubSteps > 0);
+    m_maxSubSteps = maxSubSteps;
+}
+
+auto PhysicsWorld::getInterpolationAlpha() const -> float { return m_interpolationAlpha; }
+
+auto PhysicsWorld::addBody(float mass, float inertia) -> BodyHandle
+{
+    BodyHandle body;
+    if (!m_freeBodies.empty()) {
+        body = m_freeBodies.back();
+        m_freeBodies.pop_back();
+    } else {
+        body = static_cast<BodyHandle>(m_positionX.size());
+        for (auto* array : { &m_positionX,
+                             &m_positionY,
+                             &m_rotation,
+                             &m_velocityX,
+                             &m_velocityY,
+                             &m_angularVelocity,
+                             &m_forceX,
+                             &m_forceY,
+                             &m_torque,
+                             &m_mass,
+                             &m_invMass,
+                             &m_invInertia,
+                             &m_previousPositionX,
+                             &m_previousPositionY,
+                             &m_previousRotation })
+            array->emplace_back();
+        m_isActive.emplace_back();
+        m_isAllocated.emplace_back();
+    }
+
+    m_positionX[body] = m_positionY[body] = m_rotation[body] = 0.0f;
+    m_previousPositionX[body] = m_previousPositionY[body] = m_previousRotation[body] = 0.0f;
+    m_velocityX[body] = m_velocityY[body] = m_angularVelocity[body] = 0.0f;
+    m_forceX[body] = m_forceY[body] = m_torque[body] = 0.0f;
+    m_mass[body] = mass;
+    m_invMass[body] = mass != 0.0f ? 1.0f / mass : 0.0f;
+    m_invInertia[body] = inertia != 0.0f ? 1.0f / inertia : 0.0f;
+    m_isActive[body] = 1;
+    m_isAllocated[body] = 1;
     return body;
 }
 
-void PhysicsWorld::integrate(const sf::Time& timeStep)
+void PhysicsWorld::removeBody(BodyHandle body)
 {
-    const auto stepAsSeconds = timeStep.asSeconds();
-    for (auto& body : m_bodies) {
-        // Immovable!
-        if (body->mass == 0.0f || !body->isActive) {
-            continue;
-        }
+    assert(body < m_isActive.size());
+    // A second remove would put the slot on the free list twice & hand it
+    // to two bodies
+    assert(m_isAllocated[body] != 0);
+    if (m_isAllocated[body] == 0)
+        return;
 
-        const float invMass = 1.0f / body->mass;
-        const float invInertia = 1.0f / body->inertia;
+    // Removed bodies are left in place as immovable so the integrate loop
+    // doesn't need to know about holes
+    m_isActive[body] = 0;
+    m_invMass[body] = 0.0f;
+    m_isAllocated[body] = 0;
+    m_freeBodies.push_back(body);
+}
 
-        // Linear
-        const sf::Vector2f acceleration = body->force * invMass;
+auto PhysicsWorld::getBodyCount() const -> std::size_t { return m_positionX.size() - m_freeBodies.size(); }
 
-        body->linearVelocity += acceleration * stepAsSeconds;
-        const auto speed = std::min(body->linearVelocity.length(), MAX_SPEED);
-        if (body->linearVelocity != sf::Vector2f {})
-            body->linearVelocity = body->linearVelocity.normalized() * speed;
+void PhysicsWorld::addForce(BodyHandle body, const sf::Vector2f& force)
+{
+    m_forceX[body] += force.x;
+    m_forceY[body] += force.y;
+}
 
-        body->transformable->move(body->linearVelocity * stepAsSeconds);
+void PhysicsWorld::addTorque(BodyHandle body, float torque) { m_torque[body] += torque; }
 
-        // Oriented
-        body->angularVelocity += body->torque * invInertia * stepAsSeconds;
-        body->angularVelocity = std::min(body->angularVelocity, MAX_ANGULAR_SPEED);
+void PhysicsWorld::clearForces(BodyHandle body)
+{
+    m_forceX[body] = m_forceY[body] = 0.0f;
+    m_torque[body] = 0.0f;
+}
 
-        body->transformable->rotate(sf::radians(body->angularVelocity * stepAsSeconds));
+// Setting the transform directly is a teleport, so the previous state is
+// overwritten too rather than interpolating from the old one
+void PhysicsWorld::setPosition(BodyHandle body, const sf::Vector2f& position)
+{
+    m_positionX[body] = m_previousPositionX[body] = position.x;
+    m_positionY[body] = m_previousPositionY[body] = position.y;
+}
 
-        // Clear force & torque
-        body->force = {};
-        body->torque = 0.0f;
-    }
+void PhysicsWorld::setRotation(BodyHandle body, sf::Angle rotation)
+{
+    m_rotation[body] = m_previousRotation[body] = rotation.asDegrees();
+}
+
+void PhysicsWorld::setLinearVelocity(BodyHandle body, const sf::Vector2f& velocity)
+{
+    m_velocityX[body] = velocity.x;
+    m_velocityY[body] = velocity.y;
+}
+
+void PhysicsWorld::setAngularVelocity(BodyHandle body, float velocity) { m_angularVelocity[body] = velocity; }
+
+void PhysicsWorld::setActive(BodyHandle body, bool active) { m_isActive[body] = active ? 1 : 0; }
+
+auto PhysicsWorld::getPosition(BodyHandle body) const -> sf::Vector2f
+{
+    return { m_positionX[body], m_positionY[body] };
+}
+
+auto PhysicsWorld::getRotation(BodyHandle body) const -> sf::Angle { return sf::degrees(m_rotation[body]); }
+
+auto PhysicsWorld::getPreviousPosition(BodyHandle body) const -> sf::Vector2f
+{
+    return { m_previousPositionX[body], m_previousPositionY[body] };
+}
+
+auto PhysicsWorld::getInterpolatedPosition(BodyHandle body) const -> sf::Vector2f
+{
+    const sf::Vector2f previous { m_previousPositionX[body], m_previousPositionY[body] };
+    const sf::Vector2f current { m_positionX[body], m_positionY[body] };
+    return previous + (current - previous) * m_interpolationAlpha;
+}
+
+auto PhysicsWorld::getInterpolatedRotation(BodyHandle body) const -> sf::Angle
+{
+    // Take the short way round when the rotation wrapped between steps
+    auto delta = m_rotation[body] - m_previousRotation[body];
+    if (delta > 180.0f)
+        delta -= 360.0f;
+    else if (delta < -180.0f)
+        delta += 360.0f;
+    return sf::degrees(wrap_degrees(m_previousRotation[body] + delta * m_interpolationAlpha));
+}
+
+auto PhysicsWorld::getLinearVelocity(BodyHandle body) const -> sf::Vector2f
+{
+    return { m_velocityX[body], m_velocityY[body] };
+}
+
+auto PhysicsWorld::getAngularVelocity(BodyHandle body) const -> float { return m_angularVelocity[body]; }
+
+auto PhysicsWorld::getMass(BodyHandle body) const -> float { return m_mass[body]; }
+
+auto PhysicsWorld::getBodyState(BodyHandle body) const -> BodyState
+{
+    return { { m_positionX[body], m_positionY[body] },
+             m_rotation[body],
+             { m_velocityX[body], m_velocityY[body] },
+             m_angularVelocity[body] };
+}
+
+auto PhysicsWorld::isActive(BodyHandle body) const -> bool { return m_isActive[body] != 0; }
+
+void PhysicsWorld::setIntegratorKernel(IntegratorKernel kernel)
+{
+    assert(is_integrator_kernel_supported(kernel));
+    m_integratorKernel = kernel;
+}
+
+auto PhysicsWorld::getIntegratorKernel() const -> IntegratorKernel { return m_integratorKernel; }
+
+void PhysicsWorld::integrate(const sf::Time& timeStep)
+{
+    const BodyArrays bodies { m_positionX.data(),
+                              m_positionY.data(),
+                              m_rotation.data(),
+                              m_velocityX.data(),
+                              m_velocityY.data(),
+                              m_angularVelocity.data(),
+                              m_forceX.data(),
+                              m_forceY.data(),
+                              m_torque.data(),
+                              m_invMass.data(),
+                              m_invInertia.data(),
+                              m_isActive.data(),
+                              m_positionX.size() };
+
+    integrate_bodies(m_integratorKernel, bodies, timeStep.asSeconds());
 }
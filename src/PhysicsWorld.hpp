@@ -1,34 +1,95 @@
 #pragma once
 
-#include <SFML/Graphics/Transformable.hpp>
+#include "PhysicsKernels.hpp"
+
+#include <SFML/System/Angle.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
 
-#include <memory>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
-struct PhysicsBody {
-    sf::Transformable* transformable { nullptr };
-    float mass { 0.0f };
-    float inertia { 0.0f };
-
-    float torque { 0.0f };
-    float angularVelocity { 0.0f };
-
-    sf::Vector2f force;
-    sf::Vector2f linearVelocity;
-    bool isActive { true };
-};
-
+// Bodies are stored as a structure of arrays, each body is an index into
+// them. Handles stay valid until the body is removed, removed slots are
+// reused by later calls to addBody. Removing a body twice asserts in debug
+// builds & is ignored otherwise.
 class PhysicsWorld {
 public:
+    using BodyHandle = std::uint32_t;
+    // Called after every fixed step, gameplay applies its forces for the next step here
+    using TickCallback = std::function<void(const sf::Time& timeStep)>;
+
     PhysicsWorld();
 
-    void step(const sf::Time& timeStep, const sf::Time& dt);
-    std::shared_ptr<PhysicsBody> addBody();
+    // Runs as many fixed steps as fit in the accumulated frame time, up to
+    // the max sub step count. Returns the number of steps taken.
+    auto step(const sf::Time& timeStep, const sf::Time& dt, const TickCallback& onTick = {}) -> std::uint32_t;
+
+    // Frame time beyond this many steps is dropped so a slow frame can't
+    // snowball into ever more steps (spiral of death)
+    void setMaxSubSteps(std::uint32_t maxSubSteps);
+    // How far the accumulator is between the last step and the next, in [0, 1)
+    auto getInterpolationAlpha() const -> float;
+
+    // A mass of zero creates an immovable body
+    auto addBody(float mass, float inertia) -> BodyHandle;
+    void removeBody(BodyHandle body);
+    auto getBodyCount() const -> std::size_t;
+
+    void addForce(BodyHandle body, const sf::Vector2f& force);
+    void addTorque(BodyHandle body, float torque);
+    void clearForces(BodyHandle body);
+
+    void setPosition(BodyHandle body, const sf::Vector2f& position);
+    void setRotation(BodyHandle body, sf::Angle rotation);
+    void setLinearVelocity(BodyHandle body, const sf::Vector2f& velocity);
+    void setAngularVelocity(BodyHandle body, float velocity);
+    void setActive(BodyHandle body, bool active);
+
+    auto getPosition(BodyHandle body) const -> sf::Vector2f;
+    auto getRotation(BodyHandle body) const -> sf::Angle;
+    // Position before the last step of the last call to step, the same as
+    // the position after a set. Earlier steps in the same call aren't kept.
+    auto getPreviousPosition(BodyHandle body) const -> sf::Vector2f;
+    // Blended between the previous and current step by the interpolation alpha, for rendering
+    auto getInterpolatedPosition(BodyHandle body) const -> sf::Vector2f;
+    auto getInterpolatedRotation(BodyHandle body) const -> sf::Angle;
+    auto getLinearVelocity(BodyHandle body) const -> sf::Vector2f;
+    auto getAngularVelocity(BodyHandle body) const -> float;
+    auto getMass(BodyHandle body) const -> float;
+    // Raw integrator state, rotation in degrees exactly as stored
+    auto getBodyState(BodyHandle body) const -> BodyState;
+    auto isActive(BodyHandle body) const -> bool;
+
+    // Defaults to the best kernel the CPU supports
+    void setIntegratorKernel(IntegratorKernel kernel);
+    auto getIntegratorKernel() const -> IntegratorKernel;
 
 private:
     void integrate(const sf::Time& timeStep);
 
-    std::vector<std::shared_ptr<PhysicsBody>> m_bodies;
+    std::vector<float> m_positionX;
+    std::vector<float> m_positionY;
+    std::vector<float> m_rotation; // Degrees
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_angularVelocity;
+    std::vector<float> m_forceX;
+    std::vector<float> m_forceY;
+    std::vector<float> m_torque;
+    std::vector<float> m_mass;
+    std::vector<float> m_invMass; // Zero for immovable bodies
+    std::vector<float> m_invInertia;
+    std::vector<std::uint8_t> m_isActive;
+    std::vector<std::uint8_t> m_isAllocated; // Cleared while the slot is on the free list
+    std::vector<float> m_previousPositionX;
+    std::vector<float> m_previousPositionY;
+    std::vector<float> m_previousRotation;
+
+    std::vector<BodyHandle> m_freeBodies;
+    IntegratorKernel m_integratorKernel;
     sf::Time m_accumulator;
-};
\ No newline at end of file
+    std::uint32_t m_maxSubSteps { 8 };
+    float m_interpolationAlpha { 0.0f };
+};
@@ -1,30 +1,42 @@
 #include "PlayState.hpp"
 #include "AssetHolder.hpp"
+#include "FrameArena.hpp"
 #include "GameplayBlackboard.hpp"
 #include "InputHandler.hpp"
+#include "Profiler.hpp"
 #include "SFUtility.hpp"
 
 #include <SFML/Graphics.hpp>
 #include <imgui-SFML.h>
 #include <imgui.h>
-#include <spdlog/fmt/fmt.h>
+#include <random>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <utility>
 
-constexpr auto MAX_OOB_TIME = 5;
-constexpr auto FIXED_TIME_STEP = sf::seconds(1.0f / 120.0f);
+constexpr auto INPUT_RECORDING_PATH { "last_recording.irr" };
 
 PlayState::PlayState(sf::RenderWindow& window)
     : BaseState(window)
+    , m_levelRenderer(m_gameLevel)
+    , m_aimAssist(m_gameLevel, ThreadPool::get())
     , m_rocket(m_physicsWorld, m_gameLevel, m_soundCentral)
     , m_pauseMenu(m_window, m_soundCentral, m_gameLevel)
+    , m_particles(ThreadPool::get(),
+                  std::random_device {}(),
+                  AssetHolder::get().getAtlasRegion(AssetId::Textures_Explosion))
+    , m_physicsTickRate(bb::PHYSICS_TICK_RATE)
 {
     // First we grab our asset pointers
-    auto const bgTexture { AssetHolder::get().getTexture("bin/textures/background_resized.png") };
-    auto const oobArrowTexture(AssetHolder::get().getTexture("bin/textures/oob_arrow.png"));
-    auto const font { AssetHolder::get().getFont("bin/fonts/VCR_OSD_MONO_1.001.ttf") };
+    auto const bgTexture { AssetHolder::get().getTexture(AssetId::Textures_Background_Resized) };
+    auto const oobArrowRegion(AssetHolder::get().getAtlasRegion(AssetId::Textures_Oob_Arrow));
+    auto const font { AssetHolder::get().getFont(AssetId::Fonts_VCR_OSD_MONO_1_001) };
+
+    m_physicsWorld.setMaxSubSteps(bb::MAX_PHYSICS_SUB_STEPS);
 
     m_gameLevel.loadLevel(GameLevel::Levels::One);
+    m_levelRenderer.rebuild();
+    m_recording.recordLevelLoad(GameLevel::Levels::One);
     // Static background shape & texture setup
     bgTexture->setRepeated(true);
     m_backgroundSprite.setSize(sf::Vector2f(m_window.getSize()));
@@ -33,11 +45,21 @@ PlayState::PlayState(sf::RenderWindow& window)
 
     m_uiOOB.setFont(*font);
     m_uiOOB.setFillColor(sf::Color::Yellow); // Make it catch the eye!
+    // Every countdown is built & laid out once here, so showing one during
+    // play neither allocates nor loads glyphs
+    for (int seconds = 0; seconds <= bb::MAX_OOB_TIME; ++seconds) {
+        m_uiOOBCountdown.emplace_back(fmt::format("Out of bounds!\nReset in.. {}", seconds));
+        m_uiOOB.setString(m_uiOOBCountdown.back());
+        CentreTextOrigin(m_uiOOB);
+    }
 
     // Out of bounds arrow
     m_oobDirectionIndicator.setSize({ 32.0f, 32.0f });
-    m_oobDirectionIndicator.setTexture(oobArrowTexture);
+    m_oobDirectionIndicator.setTexture(oobArrowRegion.texture);
+    m_oobDirectionIndicator.setTextureRect(oobArrowRegion.rect);
     m_oobDirectionIndicator.setOrigin({ 16.0f, 16.0f });
+
+    registerRenderables();
 }
 
 void PlayState::update(const sf::Time& dt)
@@ -70,73 +92,65 @@ void PlayState::update(const sf::Time& dt)
     }
 }
 
-void PlayState::enter() { m_rocket.levelStart(); }
-
-void PlayState::draw() const
+void PlayState::enter()
 {
-    // Gameplay oriented
-    m_window.draw(m_backgroundSprite);
-    m_window.draw(m_gameLevel);
-
-    // We want certain particle effects to render
-    // over the player, and others to render under
-    // so we'll create a sf::Drawalbe queue
-    // and sort the player &  particle effects
-    std::vector<const sf::Drawable*> drawableQueue;
-
-    for (auto& pe : m_particleEffects) {
-        if (pe->getEffectType() == ParticleEffect::Type::Rocket_Exhaust)
-            drawableQueue.push_back(pe.get());
-    }
-
-    const auto findResult
-        = std::find_if(m_particleEffects.begin(), m_particleEffects.end(), [](const auto& pe) -> bool {
-              return pe->getEffectType() == ParticleEffect::Type::Rocket_Exhaust;
-          });
-
-    if (findResult != m_particleEffects.end())
-        drawableQueue.push_back(findResult->get());
-
-    drawableQueue.push_back(&m_rocket);
-    for (const auto& pe : m_particleEffects) {
-        if (pe->getEffectType() != ParticleEffect::Type::Rocket_Exhaust)
-            drawableQueue.push_back(pe.get());
-    }
-
-    for (auto& drawable : drawableQueue)
-        m_window.draw(*drawable);
-
-    if (m_isOutOfBounds) {
-        m_window.draw(m_oobDirectionIndicator);
-    }
-
-    if (m_isOutOfBounds) {
-        m_window.draw(m_uiOOB);
-    }
-
-    if (m_status == PlayState::Status::Paused) {
-        m_window.draw(m_pauseMenu);
-    }
+    m_rocket.levelStart();
+    m_recording.recordReset();
 }
 
+void PlayState::draw() const { m_renderQueue.draw(m_window); }
+
 void PlayState::updatePlaying(const sf::Time& dt)
 {
     auto& input = InputHandler::get();
     const bool skipLevel = input.debugSkipPressed();
 
-    // Update core gameplay & ImGui
-    m_physicsWorld.step(FIXED_TIME_STEP, dt);
+    // Update core gameplay & ImGui, rocket rules run once per physics step
+    // so they don't depend on the frame rate
+    ImGui::Begin("Debug");
+    ImGui::SliderInt("Physics Tick Rate", &m_physicsTickRate, 30, 240);
+    ImGui::Checkbox("Aim Assist", &m_isAimAssistEnabled);
+    if (ImGui::Button("Save Recording"))
+        saveRecording();
+    const auto& renderStats = m_renderQueue.getStats();
+    ImGui::Text("Draw Calls %zu, Vertices %zu, Sprites %zu",
+                renderStats.drawCalls,
+                renderStats.vertexCount,
+                renderStats.quadCount);
+    ImGui::Text("Frame Arena %zu / %zu bytes",
+                FrameArena::get().getLastFrameUsage(),
+                FrameArena::get().getCapacity());
+    ImGui::End();
+
+    // Everything that feeds the steps is recorded so the run can be replayed
+    // with impossible-rocket-sim --replay
+    const auto inputState = input.getInputState();
+    const auto timeStep = sf::seconds(1.0f / static_cast<float>(m_physicsTickRate));
+    if (timeStep != m_recordedTimeStep) {
+        m_recording.recordTimeStep(timeStep);
+        m_recordedTimeStep = timeStep;
+    }
+    m_physicsWorld.step(timeStep, dt, [&](const sf::Time&) {
+        m_recording.recordTick(inputState);
+        m_rocket.fixedUpdate(inputState);
+    });
+    if (m_isAimAssistEnabled && !m_rocket.getCollisionInfo())
+        m_aimAssist.update(m_rocket.getBodyState(), m_rocket.getSweepStart(), inputState, timeStep);
     m_gameLevel.update(dt);
-    m_rocket.update(dt);
+    m_levelRenderer.update();
+    m_rocket.update();
 
-    for (auto& e : m_particleEffects) {
-        e->update(dt);
+#if defined(IMPOSSIBLE_ROCKET_DEBUG)
+    if (input.wasHaltKeyPressed()) {
+        m_rocket.halt();
+        m_recording.recordHalt();
     }
+#endif
 
-    if (input.wasResetPressed()) {
-        m_gameLevel.resetLevel();
-        m_rocket.levelStart();
-    }
+    m_particles.update(dt);
+
+    if (input.wasResetPressed())
+        resetLevel();
 
     outOfBoundsUpdate();
     particleEffectUpdate();
@@ -147,6 +161,7 @@ void PlayState::updatePlaying(const sf::Time& dt)
             m_pauseMenu.reset();
             m_pauseMenu.setSubMenuStage(PauseMenu::SubMenuStage::LevelSummary);
             m_status = Status::Paused;
+            prefetchNextLevel();
         }
     }
 }
@@ -154,21 +169,64 @@ void PlayState::updatePlaying(const sf::Time& dt)
 void PlayState::updatePaused(const sf::Time& dt)
 {
     m_pauseMenu.update(dt);
+    // Continue was clicked before the prefetch finished
+    if (m_pauseMenu.getStage() == PauseMenu::SubMenuStage::Loading) {
+        if (isNextLevelReady()) {
+            startNextLevel();
+            m_status = PlayState::Status::Playing;
+        }
+        return;
+    }
+
     if (m_pauseMenu.returnToPlaying()) {
         if (m_pauseMenu.getStage() == PauseMenu::SubMenuStage::LevelSummary) {
-            const auto current = static_cast<std::uint32_t>(m_gameLevel.getCurrentLevel());
-            if (current + 1 >= static_cast<std::uint32_t>(GameLevel::Levels::MAX_LEVEL)) {
+            if (!m_nextLevel.valid()) {
                 // Do game completion here.
                 spdlog::debug("All Levels Complete");
+            } else if (isNextLevelReady()) {
+                startNextLevel();
             } else {
-                m_gameLevel.loadLevel(static_cast<GameLevel::Levels>(current + 1));
-                m_rocket.levelStart();
+                m_pauseMenu.setSubMenuStage(PauseMenu::SubMenuStage::Loading);
+                return;
             }
         }
         m_status = PlayState::Status::Playing;
     }
 }
 
+void PlayState::prefetchNextLevel()
+{
+    const auto current = static_cast<std::uint32_t>(m_gameLevel.getCurrentLevel());
+    if (m_nextLevel.valid() || current + 1 >= static_cast<std::uint32_t>(GameLevel::Levels::MAX_LEVEL))
+        return;
+
+    // A thread of its own rather than the pool, a load queued there would
+    // tie up a worker the frame's parallelFors could be using for frames.
+    // The settings are copied here as the current level is in use meanwhile.
+    const auto next = static_cast<GameLevel::Levels>(current + 1);
+    GameLevel level;
+    level.copySettings(m_gameLevel);
+    m_nextLevel = std::async(std::launch::async, [next, level = std::move(level)]() mutable {
+        level.loadLevel(next);
+        return std::move(level);
+    });
+}
+
+auto PlayState::isNextLevelReady() const -> bool
+{
+    return m_nextLevel.valid() && m_nextLevel.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void PlayState::startNextLevel()
+{
+    PROFILE_ZONE("PlayState::startNextLevel");
+    // Swapped in whole between frames, a load error on the worker is rethrown here
+    m_gameLevel = m_nextLevel.get();
+    m_levelRenderer.rebuild();
+    m_rocket.levelStart();
+    m_recording.recordLevelLoad(m_gameLevel.getCurrentLevel());
+}
+
 void PlayState::particleEffectUpdate()
 {
     // If the player collides with a planet then
@@ -176,55 +234,25 @@ void PlayState::particleEffectUpdate()
     // once the effect is complete, we'll reset
     const auto collisionInfo = m_rocket.getCollisionInfo();
     if (collisionInfo) {
-        auto result = std::find_if(m_particleEffects.begin(), m_particleEffects.end(), [](const auto& effect) -> bool {
-            return effect->getEffectType() == ParticleEffect::Type::Planet_Collision;
-        });
-        // If we don't find an effect for the collision
-        // then we'll add it
-        if (result == m_particleEffects.end()) {
-            // Add particle effect
-            m_particleEffects.push_back(std::make_unique<ParticleEffect>(
-                ParticleEffect::Type::Planet_Collision, collisionInfo.value().point, collisionInfo.value().normal));
-        } else {
-            if (!(*result)->isPlaying()) {
-                m_rocket.levelStart();
-                m_gameLevel.resetLevel();
-            }
+        if (!m_isCollisionEffectStarted) {
+            m_particles.burst(ParticleSystem::Type::Planet_Collision, collisionInfo->point, collisionInfo->normal);
+            m_isCollisionEffectStarted = true;
+        } else if (!m_particles.isPlaying(ParticleSystem::Type::Planet_Collision)) {
+            resetLevel();
         }
     }
 
-    // If the player is moving, lets add a particle effect for the exhaust
-    // once they stop we'll remove it. Really we should opt for never
-    // removing this effect, and only stop it.
-    // TODO: Don't remove this effect every time, add a pause mechanism for it
-    // instead
-    auto exhaustParticleEffect
-        = std::find_if(m_particleEffects.begin(), m_particleEffects.end(), [](const auto& effect) -> bool {
-              return effect->getEffectType() == ParticleEffect::Type::Rocket_Exhaust;
-          });
+    if (m_rocket.getFrameEvents().objectivesCollected > 0)
+        m_particles.burst(ParticleSystem::Type::Objective_Collected, m_rocket.getPosition(), {});
+
+    // The exhaust follows the rocket while it thrusts, once it stops the
+    // particles already emitted play out
     if (m_rocket.isPlayerApplyingForce()) {
-        if (exhaustParticleEffect == m_particleEffects.end()) {
-            m_particleEffects.push_back(std::make_unique<ParticleEffect>(
-                ParticleEffect::Type::Rocket_Exhaust, m_rocket.getExhaustPoint(), m_rocket.getExhaustDirection()));
-        } else {
-            // Update the effect position
-            (*exhaustParticleEffect)->setPosition(m_rocket.getExhaustPoint());
-            (*exhaustParticleEffect)->setNormal(m_rocket.getExhaustDirection());
-        }
+        m_particles.setEmitter(
+            ParticleSystem::Type::Rocket_Exhaust, m_rocket.getExhaustPoint(), m_rocket.getExhaustDirection());
+        m_particles.start(ParticleSystem::Type::Rocket_Exhaust);
     } else {
-        if (exhaustParticleEffect != m_particleEffects.end()) {
-            if ((*exhaustParticleEffect)->isPlaying())
-                (*exhaustParticleEffect)->stop();
-        }
-    }
-
-    // Remove completed particle effects
-    if (!m_particleEffects.empty()) {
-        m_particleEffects.erase(
-            std::remove_if(m_particleEffects.begin(),
-                           m_particleEffects.end(),
-                           [](std::unique_ptr<ParticleEffect>& pe) -> bool { return !pe->isPlaying(); }),
-            m_particleEffects.end());
+        m_particles.stop(ParticleSystem::Type::Rocket_Exhaust);
     }
 }
 
@@ -242,8 +270,8 @@ void PlayState::outOfBoundsUpdate()
     if (m_isOutOfBounds) {
         // Update our ui text
         const auto seconds = static_cast<std::int32_t>(m_oobTimer.getElapsedTime().asSeconds());
-        auto remaining = std::max(MAX_OOB_TIME - seconds, 0);
-        m_uiOOB.setString(fmt::format("Out of bounds!\nReset in.. {}", remaining));
+        auto remaining = std::max(bb::MAX_OOB_TIME - seconds, 0);
+        m_uiOOB.setString(m_uiOOBCountdown[static_cast<std::size_t>(remaining)]);
         CentreTextOrigin(m_uiOOB);
         const auto windowSize = sf::Vector2f { m_window.getSize() };
         m_uiOOB.setPosition(windowSize * 0.5f);
@@ -267,9 +295,62 @@ void PlayState::outOfBoundsUpdate()
 
         m_oobDirectionIndicator.setPosition(clampedPosition);
         if (remaining == 0) {
-            m_gameLevel.resetLevel();
-            m_rocket.levelStart();
+            resetLevel();
             m_isOutOfBounds = false;
         }
     }
 }
+
+void PlayState::resetLevel()
+{
+    m_isCollisionEffectStarted = false;
+    m_gameLevel.resetLevel();
+    m_rocket.levelStart();
+    m_recording.recordReset();
+}
+
+void PlayState::registerRenderables()
+{
+    using Layer = RenderQueue::Layer;
+    const auto addParticles = [this](Layer layer, ParticleSystem::Type type) {
+        m_renderQueue.add(layer, [this, type](SpriteBatch& batch) {
+            batch.add(m_particles.getEffect(type), m_particles.getParticleCount(type) * 6);
+        });
+    };
+
+    // Sprites in the atlas between two other draws share one draw call
+    m_renderQueue.add(Layer::Background, [this](SpriteBatch& batch) { batch.add(m_backgroundSprite); });
+    m_renderQueue.add(Layer::Level, [this](SpriteBatch& batch) { m_levelRenderer.addTo(batch); });
+    m_renderQueue.add(Layer::Level, [this](SpriteBatch& batch) {
+        if (m_isAimAssistEnabled && !m_rocket.getCollisionInfo())
+            batch.add(m_aimAssist, m_aimAssist.getVertexCount());
+    });
+
+    // Exhaust renders under the player, every other effect over it
+    addParticles(Layer::Under_Player_Effects, ParticleSystem::Type::Rocket_Exhaust);
+    m_renderQueue.add(Layer::Player, [this](SpriteBatch& batch) { m_rocket.addTo(batch); });
+    addParticles(Layer::Over_Player_Effects, ParticleSystem::Type::Planet_Collision);
+    addParticles(Layer::Over_Player_Effects, ParticleSystem::Type::Objective_Collected);
+
+    // Text & menu vertices aren't counted
+    m_renderQueue.add(Layer::UI, [this](SpriteBatch& batch) {
+        if (m_isOutOfBounds) {
+            batch.add(m_oobDirectionIndicator);
+            batch.add(m_uiOOB, 0);
+        }
+    });
+    m_renderQueue.add(Layer::UI, [this](SpriteBatch& batch) {
+        if (m_status == PlayState::Status::Paused)
+            batch.add(m_pauseMenu, 0);
+    });
+}
+
+void PlayState::saveRecording() const
+{
+    try {
+        m_recording.saveToFile(INPUT_RECORDING_PATH);
+        spdlog::info("Saved {} ticks to {}", m_recording.getTickCount(), INPUT_RECORDING_PATH);
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+    }
+}
@@ -1,14 +1,19 @@
 #pragma once
 
+#include "AimAssistOverlay.hpp"
 #include "BaseState.hpp"
 #include "GameLevel.hpp"
-#include "ParticleEffect.hpp"
+#include "InputRecording.hpp"
+#include "LevelRenderer.hpp"
+#include "ParticleSystem.hpp"
 #include "PauseMenu.hpp"
 #include "PhysicsWorld.hpp"
 #include "PlayerRocket.hpp"
+#include "RenderQueue.hpp"
 #include "SoundCentral.hpp"
 
-#include <memory>
+#include <future>
+#include <vector>
 
 class PlayState : public BaseState {
 public:
@@ -26,19 +31,37 @@ private:
     void updatePaused(const sf::Time& dt);
     void particleEffectUpdate();
     void outOfBoundsUpdate();
+    void resetLevel();
+    // Loads the level after the current one off the main thread
+    void prefetchNextLevel();
+    auto isNextLevelReady() const -> bool;
+    void startNextLevel();
+    // Everything the state draws goes into the render queue once, here
+    void registerRenderables();
+    void saveRecording() const;
 
     SoundCentral m_soundCentral;
     PhysicsWorld m_physicsWorld;
     GameLevel m_gameLevel;
+    std::future<GameLevel> m_nextLevel; // Valid from level complete until the next level starts
+    LevelRenderer m_levelRenderer;
+    AimAssistOverlay m_aimAssist;
     PlayerRocket m_rocket;
     PauseMenu m_pauseMenu;
 
     sf::RectangleShape m_backgroundSprite;
     sf::RectangleShape m_oobDirectionIndicator;
     sf::Text m_uiOOB;
+    std::vector<sf::String> m_uiOOBCountdown; // Indexed by seconds remaining
     sf::Clock m_oobTimer; // out of bounds timer
 
-    std::vector<std::unique_ptr<ParticleEffect>> m_particleEffects;
+    ParticleSystem m_particles;
+    mutable RenderQueue m_renderQueue;
+    InputRecording m_recording;
+    sf::Time m_recordedTimeStep; // Last time step written to the recording
+    int m_physicsTickRate; // Steps per second, adjustable from the debug window
+    bool m_isAimAssistEnabled { false };
     bool m_isOutOfBounds { false };
+    bool m_isCollisionEffectStarted { false };
     PlayState::Status m_status { PlayState::Status::Playing };
 };
@@ -5,84 +5,68 @@
 #include "GameplayBlackboard.hpp"
 #include <array>
 #include <cassert>
+#include <utility>
 #include <imgui-SFML.h>
 #include <imgui.h>
 
 PlayerRocket::PlayerRocket(PhysicsWorld& world, GameLevel& levelGeometry, SoundCentral& soundCentral)
-    : m_body(world.addBody())
-    , m_gameLevel(levelGeometry)
+    : m_controller(world, levelGeometry)
     , m_soundCentral(&soundCentral)
 {
     m_shape.setOrigin(bb::ROCKET_SIZE * 0.5f);
-    m_body->inertia = 1.0e3f;
-    m_body->mass = 1.0e5f;
-    m_body->transformable = &m_shape;
 
-    auto texture { AssetHolder::get().getTexture("bin/textures/ship.png") };
-    m_shape.setTexture(texture);
-    m_shape.setSize(sf::Vector2f { texture->getSize() });
+    const auto region = AssetHolder::get().getAtlasRegion(AssetId::Textures_Ship);
+    m_shape.setTexture(region.texture);
+    m_shape.setTextureRect(region.rect);
+    m_shape.setSize(sf::Vector2f(region.rect.getSize()));
 }
 
-void PlayerRocket::update(const sf::Time& dt)
+void PlayerRocket::fixedUpdate(const InputState& input)
 {
-    (void)dt;
-    const auto state = InputHandler::get().getInputState();
-    const auto direction = sf::Vector2f(1.0f, m_shape.getRotation());
-
-    if (state.linear_thrust != 0.0f) {
-        m_body->force += direction * (bb::THRUST_FORCE * state.linear_thrust);
-    }
+    const auto events = m_controller.update(input);
+    m_pendingEvents.collidedWithPlanet |= events.collidedWithPlanet;
+    m_pendingEvents.objectivesCollected += events.objectivesCollected;
+}
 
-    if (state.angular_thrust != 0.0f) {
-        m_body->torque += bb::TORQUE_MAG * state.angular_thrust;
-    }
+void PlayerRocket::update()
+{
+    syncShape();
 
-    auto result = m_gameLevel.doesCollideWithPlanet(m_shape.getPosition(), bb::ROCKET_SIZE.x / 2.0f);
-    if (result) {
-        m_body->isActive = false;
-        m_collisionInfo = result;
+    m_frameEvents = std::exchange(m_pendingEvents, {});
+    const auto& events = m_frameEvents;
+    if (events.collidedWithPlanet) {
         if (m_soundCentral->getSoundStatus(SoundCentral::SoundEffectTypes::PlanetCollision)
             != sf::Sound::Status::Playing)
             m_soundCentral->playSoundEffect(SoundCentral::SoundEffectTypes::PlanetCollision);
     }
 
-    m_gameLevel.handleObjectiveIntersections(m_shape.getPosition(), bb::ROCKET_SIZE.x / 2.0f);
-
-    m_body->force += m_gameLevel.getSummedForce(m_shape.getPosition(), m_body->mass);
-
-#if defined(IMPOSSIBLE_ROCKET_DEBUG)
-    if (InputHandler::get().wasHaltKeyPressed()) {
-        m_body->force = {};
-        m_body->linearVelocity = {};
-        m_body->angularVelocity = 0.0f;
-        m_body->torque = 0.0f;
+    if (events.objectivesCollected > 0) {
+        if (m_soundCentral->getSoundStatus(SoundCentral::SoundEffectTypes::ObjectiveCollected)
+            != sf::Sound::Status::Playing)
+            m_soundCentral->playSoundEffect(SoundCentral::SoundEffectTypes::ObjectiveCollected);
     }
-#endif
 
+    const auto linearVelocity = m_controller.getLinearVelocity();
     ImGui::Begin("Debug");
-    ImGui::Text("Linear Velocity {%f - %f}", m_body->linearVelocity.x, m_body->linearVelocity.y);
-    ImGui::Text("Angular Velocity {%f}", m_body->angularVelocity);
-    ImGui::Text("Speed {%f}", m_body->linearVelocity.length());
+    ImGui::Text("Linear Velocity {%f - %f}", linearVelocity.x, linearVelocity.y);
+    ImGui::Text("Angular Velocity {%f}", m_controller.getAngularVelocity());
+    ImGui::Text("Speed {%f}", linearVelocity.length());
     ImGui::End();
 }
 
 void PlayerRocket::levelStart()
 {
-    m_collisionInfo.reset();
-
     // Shape & physics reset
-    m_shape.setPosition(m_gameLevel.getPlayerStart());
-    m_shape.setRotation(sf::degrees(0.0f));
-
-    m_body->angularVelocity = 0.0f;
-    m_body->linearVelocity = {};
-    m_body->force = {};
-    m_body->torque = 0.0f;
-    m_body->isActive = true;
+    m_controller.reset();
+    m_pendingEvents = {};
+    m_frameEvents = {};
+    syncShape();
 
     m_soundCentral->playSoundEffect(SoundCentral::SoundEffectTypes::LevelStart);
 }
 
+void PlayerRocket::halt() { m_controller.halt(); }
+
 auto PlayerRocket::isInBounds(const sf::RenderWindow& window) const -> bool
 {
     const auto& view = window.getView();
@@ -90,7 +74,12 @@ auto PlayerRocket::isInBounds(const sf::RenderWindow& window) const -> bool
     return bounds.findIntersection(m_shape.getGlobalBounds()).has_value();
 }
 
-auto PlayerRocket::getCollisionInfo() const -> std::optional<GameLevel::PlanetCollisionInfo> { return m_collisionInfo; }
+auto PlayerRocket::getCollisionInfo() const -> std::optional<GameLevel::PlanetCollisionInfo>
+{
+    return m_controller.getCollisionInfo();
+}
+
+auto PlayerRocket::getFrameEvents() const -> const RocketController::Events& { return m_frameEvents; }
 
 auto PlayerRocket::getPosition() const -> sf::Vector2f { return m_shape.getPosition(); }
 
@@ -115,7 +104,14 @@ auto PlayerRocket::isPlayerApplyingForce() const -> bool
 
 auto PlayerRocket::getRotation() const -> sf::Angle { return m_shape.getRotation(); }
 
-void PlayerRocket::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+auto PlayerRocket::getBodyState() const -> BodyState { return m_controller.getBodyState(); }
+
+auto PlayerRocket::getSweepStart() const -> sf::Vector2f { return m_controller.getSweepStart(); }
+
+void PlayerRocket::addTo(SpriteBatch& batch) const { batch.add(m_shape); }
+
+void PlayerRocket::syncShape()
 {
-    target.draw(m_shape, states);
+    m_shape.setPosition(m_controller.getInterpolatedPosition());
+    m_shape.setRotation(m_controller.getInterpolatedRotation());
 }
\ No newline at end of file
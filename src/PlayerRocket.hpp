@@ -7,32 +7,45 @@
 
 #include "GameLevel.hpp"
 #include "PhysicsWorld.hpp"
+#include "RocketController.hpp"
 #include "SoundCentral.hpp"
+#include "SpriteBatch.hpp"
 
-class PlayerRocket : public sf::Drawable {
+class PlayerRocket {
 public:
     PlayerRocket(PhysicsWorld& world, GameLevel& levelGeometry, SoundCentral& soundCentral);
-    void update(const sf::Time& dt);
+    // Runs the rocket gameplay rules, called once per physics step
+    void fixedUpdate(const InputState& input);
+    // Per frame, plays sounds for the steps since the last frame & places
+    // the shape between the last two physics states
+    void update();
 
     void levelStart();
+    // Debug only, stops the rocket dead
+    void halt();
 
     auto isInBounds(const sf::RenderWindow& window) const -> bool;
     auto getCollisionInfo() const -> std::optional<GameLevel::PlanetCollisionInfo>;
+    // Everything that happened over the physics steps since the last frame
+    auto getFrameEvents() const -> const RocketController::Events&;
 
     auto getPosition() const -> sf::Vector2f;
     auto getExhaustPoint() const -> sf::Vector2f;
     auto getExhaustDirection() const -> sf::Vector2f;
     auto isPlayerApplyingForce() const -> bool;
     auto getRotation() const -> sf::Angle;
+    auto getBodyState() const -> BodyState;
+    auto getSweepStart() const -> sf::Vector2f;
 
-protected:
-    virtual void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
+    void addTo(SpriteBatch& batch) const;
 
 private:
-    std::shared_ptr<PhysicsBody> m_body;
+    void syncShape();
+
+    RocketController m_controller;
+    RocketController::Events m_pendingEvents;
+    RocketController::Events m_frameEvents;
     sf::RectangleShape m_shape;
-    GameLevel& m_gameLevel;
 
-    std::optional<GameLevel::PlanetCollisionInfo> m_collisionInfo;
     SoundCentral* m_soundCentral;
-};
\ No newline at end of file
+};
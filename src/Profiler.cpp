@@ -0,0 +1,141 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+// Recent durations kept per zone for the stats & plot
+constexpr std::size_t ZONE_SAMPLE_COUNT { 600 };
+
+namespace {
+auto to_milliseconds(Profiler::Clock::duration duration) -> float
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+auto to_microseconds(Profiler::Clock::duration duration) -> double
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+}
+
+Profiler::Scope::Scope(ZoneId zone)
+    : m_zone(zone)
+    , m_start(Clock::now())
+{
+}
+
+Profiler::Scope::~Scope() { Profiler::get().record(m_zone, m_start, Clock::now()); }
+
+Profiler::Profiler()
+    : m_epoch(Clock::now())
+{
+}
+
+auto Profiler::registerZone(const char* name) -> ZoneId
+{
+    std::lock_guard lock(m_mutex);
+    Zone zone;
+    zone.name = name;
+    zone.samplesMs.resize(ZONE_SAMPLE_COUNT);
+    m_zones.push_back(std::move(zone));
+    return m_zones.size() - 1;
+}
+
+void Profiler::record(ZoneId zone, Clock::time_point start, Clock::time_point end)
+{
+    std::lock_guard lock(m_mutex);
+    auto& z = m_zones[zone];
+    z.samplesMs[z.nextSample] = to_milliseconds(end - start);
+    z.nextSample = (z.nextSample + 1) % z.samplesMs.size();
+    z.sampleCount = std::min(z.sampleCount + 1, z.samplesMs.size());
+
+    if (m_captureFramesLeft > 0)
+        m_trace.push_back({ zone, getThreadIndex(std::this_thread::get_id()), start, end });
+}
+
+void Profiler::endFrame()
+{
+    std::lock_guard lock(m_mutex);
+    if (m_captureFramesLeft > 0 && --m_captureFramesLeft == 0) {
+        saveTrace();
+        m_trace.clear();
+    }
+}
+
+void Profiler::startCapture(std::size_t frameCount, const std::filesystem::path& path)
+{
+    std::lock_guard lock(m_mutex);
+    m_trace.clear();
+    m_captureFramesLeft = frameCount;
+    m_capturePath = path;
+}
+
+auto Profiler::isCapturing() const -> bool
+{
+    std::lock_guard lock(m_mutex);
+    return m_captureFramesLeft > 0;
+}
+
+void Profiler::getZoneStats(std::vector<ZoneStats>& stats) const
+{
+    std::lock_guard lock(m_mutex);
+    std::size_t count = 0;
+    for (const auto& zone : m_zones) {
+        if (zone.sampleCount == 0)
+            continue;
+
+        if (count == stats.size())
+            stats.emplace_back();
+        auto& zoneStats = stats[count++];
+        zoneStats.name = zone.name;
+        // Unroll the ring buffer so the plot reads oldest to newest
+        const auto first = (zone.nextSample + zone.samplesMs.size() - zone.sampleCount) % zone.samplesMs.size();
+        zoneStats.samplesMs.resize(zone.sampleCount);
+        for (std::size_t i = 0; i < zone.sampleCount; ++i)
+            zoneStats.samplesMs[i] = zone.samplesMs[(first + i) % zone.samplesMs.size()];
+
+        auto& sorted = m_sortedSamples;
+        sorted.assign(zoneStats.samplesMs.begin(), zoneStats.samplesMs.end());
+        std::sort(sorted.begin(), sorted.end());
+        zoneStats.minMs = sorted.front();
+        zoneStats.avgMs = std::accumulate(sorted.begin(), sorted.end(), 0.0f) / static_cast<float>(sorted.size());
+        // Nearest rank, so a few samples report their slowest
+        zoneStats.p99Ms = sorted[(sorted.size() * 99 + 99) / 100 - 1];
+    }
+    stats.resize(count);
+}
+
+auto Profiler::getThreadIndex(std::thread::id id) -> std::uint32_t
+{
+    const auto result = std::find(m_threads.begin(), m_threads.end(), id);
+    if (result != m_threads.end())
+        return static_cast<std::uint32_t>(result - m_threads.begin());
+
+    m_threads.push_back(id);
+    return static_cast<std::uint32_t>(m_threads.size() - 1);
+}
+
+void Profiler::saveTrace() const
+{
+    // Complete ("X") events, timestamps & durations in microseconds
+    std::ofstream file(m_capturePath, std::ios::trunc);
+    file << "{\"traceEvents\":[\n";
+    for (std::size_t i = 0; i < m_trace.size(); ++i) {
+        const auto& e = m_trace[i];
+        file << fmt::format("{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}{}\n",
+                            m_zones[e.zone].name,
+                            e.thread,
+                            to_microseconds(e.start - m_epoch),
+                            to_microseconds(e.end - e.start),
+                            i + 1 < m_trace.size() ? "," : "");
+    }
+    file << "]}\n";
+
+    if (file.good())
+        spdlog::info("Saved {} profiler events to {}", m_trace.size(), m_capturePath.string());
+    else
+        spdlog::error("Unable to write profiler trace {}", m_capturePath.string());
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scoped zone timers for finding where frame time goes. Each zone keeps its
+// most recent durations for min/avg/p99 & a plot, and a capture records
+// every zone over a number of frames as Chrome trace JSON (chrome://tracing
+// or Perfetto). Zones are only compiled in with IMPOSSIBLE_ROCKET_PROFILE,
+// which the build defines outside release builds.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ZoneId = std::size_t;
+
+    static Profiler& get()
+    {
+        static Profiler& instance = *new Profiler();
+        return instance;
+    }
+
+    // Times the enclosing scope, see PROFILE_ZONE
+    class Scope {
+    public:
+        explicit Scope(ZoneId zone);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ZoneId m_zone;
+        Clock::time_point m_start;
+    };
+
+    struct ZoneStats {
+        std::string name;
+        float minMs { 0.0f };
+        float avgMs { 0.0f };
+        float p99Ms { 0.0f };
+        std::vector<float> samplesMs; // Oldest first
+    };
+
+    auto registerZone(const char* name) -> ZoneId;
+    void record(ZoneId zone, Clock::time_point start, Clock::time_point end);
+    // Call once per frame, counts down a running capture
+    void endFrame();
+
+    // Records every zone for the next frameCount frames, then writes them to path
+    void startCapture(std::size_t frameCount, const std::filesystem::path& path);
+    auto isCapturing() const -> bool;
+
+    // Over each zone's recent samples, zones with none are skipped. Fills
+    // stats in place, so a vector kept between calls stops allocating.
+    void getZoneStats(std::vector<ZoneStats>& stats) const;
+
+private:
+    struct Zone {
+        std::string name;
+        std::vector<float> samplesMs; // Ring buffer
+        std::size_t nextSample { 0 };
+        std::size_t sampleCount { 0 };
+    };
+
+    struct TraceEvent {
+        ZoneId zone { 0 };
+        std::uint32_t thread { 0 };
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    Profiler();
+
+    auto getThreadIndex(std::thread::id id) -> std::uint32_t;
+    void saveTrace() const;
+
+    mutable std::mutex m_mutex;
+    std::vector<Zone> m_zones;
+    std::vector<std::thread::id> m_threads; // Index is the trace's thread id
+    std::vector<TraceEvent> m_trace;
+    mutable std::vector<float> m_sortedSamples; // Scratch for getZoneStats
+    std::size_t m_captureFramesLeft { 0 };
+    std::filesystem::path m_capturePath;
+    Clock::time_point m_epoch;
+};
+
+#if defined(IMPOSSIBLE_ROCKET_PROFILE)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// Times the rest of the enclosing scope under name, a string literal
+#define PROFILE_ZONE(name)                                                                                             \
+    static const auto PROFILE_CONCAT(profileZone, __LINE__) = Profiler::get().registerZone(name);                     \
+    const Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileZone, __LINE__))
+#define PROFILE_END_FRAME() Profiler::get().endFrame()
+#else
+#define PROFILE_ZONE(name) static_cast<void>(0)
+#define PROFILE_END_FRAME() static_cast<void>(0)
+#endif
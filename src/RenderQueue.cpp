@@ -0,0 +1,24 @@
+#include "RenderQueue.hpp"
+
+#include <cassert>
+#include <utility>
+
+void RenderQueue::add(Layer layer, Submit submit)
+{
+    assert(layer < Layer::MAX_LAYER);
+    m_layers[static_cast<std::size_t>(layer)].push_back(std::move(submit));
+}
+
+void RenderQueue::draw(sf::RenderTarget& target)
+{
+    // The batch only sorts quads by texture within a layer, a layer never
+    // draws over the one after it
+    for (const auto& layer : m_layers) {
+        for (const auto& submit : layer)
+            submit(m_batch);
+        m_batch.addBarrier();
+    }
+    m_batch.flush(target);
+}
+
+auto RenderQueue::getStats() const -> const SpriteBatch::Stats& { return m_batch.getStats(); }
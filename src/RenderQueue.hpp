@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SpriteBatch.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+// Everything a scene draws, registered once per layer. Each frame the
+// layers are walked in order & every entry adds itself to the sprite batch,
+// which draws the lot, so ordering is fixed at registration rather than
+// worked out per frame. Entries in a layer draw in the order they were
+// added, except that quads with different textures may be sorted by texture
+// within the layer. Once the batch's buffers have grown nothing allocates per
+// frame.
+class RenderQueue {
+public:
+    enum class Layer { Background, Level, Under_Player_Effects, Player, Over_Player_Effects, UI, MAX_LAYER };
+
+    // Adds whatever should be drawn this frame, or nothing to skip it
+    using Submit = std::function<void(SpriteBatch& batch)>;
+
+    void add(Layer layer, Submit submit);
+    void draw(sf::RenderTarget& target);
+
+    // Counted over the last draw
+    auto getStats() const -> const SpriteBatch::Stats&;
+
+private:
+    std::array<std::vector<Submit>, static_cast<std::size_t>(Layer::MAX_LAYER)> m_layers;
+    SpriteBatch m_batch;
+};
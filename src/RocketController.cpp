@@ -0,0 +1,90 @@
+#include "RocketController.hpp"
+#include "GameplayBlackboard.hpp"
+
+RocketController::RocketController(PhysicsWorld& world, GameLevel& level)
+    : m_world(world)
+    , m_body(world.addBody(bb::ROCKET_MASS, bb::ROCKET_INERTIA))
+    , m_gameLevel(level)
+    , m_sweepStart(world.getPosition(m_body))
+{
+}
+
+auto RocketController::update(const InputState& input) -> Events
+{
+    Events events;
+    // The world only keeps the state before the last step of a frame, the
+    // sweep needs the state before this step
+    const auto previousPosition = m_sweepStart;
+    auto position = m_world.getPosition(m_body);
+    const auto direction = sf::Vector2f(1.0f, m_world.getRotation(m_body));
+
+    if (input.linear_thrust != 0.0f) {
+        m_world.addForce(m_body, direction * (bb::THRUST_FORCE * input.linear_thrust));
+    }
+
+    if (input.angular_thrust != 0.0f) {
+        m_world.addTorque(m_body, bb::TORQUE_MAG * input.angular_thrust);
+    }
+
+    // Swept over the last step so a fast rocket can't pass through anything
+    auto result = m_gameLevel.doesCollideWithPlanet(previousPosition, position, bb::ROCKET_SIZE.x / 2.0f);
+    if (result) {
+        // Stops where it hit rather than inside or past the planet
+        position = result->position;
+        m_world.setPosition(m_body, position);
+        m_world.setActive(m_body, false);
+        m_collisionInfo = result;
+        events.collidedWithPlanet = true;
+    }
+
+    events.objectivesCollected
+        = m_gameLevel.handleObjectiveIntersections(previousPosition, position, bb::ROCKET_SIZE.x / 2.0f);
+
+    m_world.addForce(m_body, m_gameLevel.getSummedForce(position, m_world.getMass(m_body)));
+    m_sweepStart = position;
+    return events;
+}
+
+void RocketController::reset()
+{
+    m_collisionInfo.reset();
+
+    m_world.setPosition(m_body, m_gameLevel.getPlayerStart());
+    m_sweepStart = m_gameLevel.getPlayerStart();
+    m_world.setRotation(m_body, sf::degrees(0.0f));
+    m_world.setAngularVelocity(m_body, 0.0f);
+    m_world.setLinearVelocity(m_body, {});
+    m_world.clearForces(m_body);
+    m_world.setActive(m_body, true);
+}
+
+void RocketController::halt()
+{
+    m_world.clearForces(m_body);
+    m_world.setLinearVelocity(m_body, {});
+    m_world.setAngularVelocity(m_body, 0.0f);
+}
+
+auto RocketController::getCollisionInfo() const -> std::optional<GameLevel::PlanetCollisionInfo>
+{
+    return m_collisionInfo;
+}
+
+auto RocketController::getPosition() const -> sf::Vector2f { return m_world.getPosition(m_body); }
+
+auto RocketController::getRotation() const -> sf::Angle { return m_world.getRotation(m_body); }
+
+auto RocketController::getInterpolatedPosition() const -> sf::Vector2f
+{
+    return m_world.getInterpolatedPosition(m_body);
+}
+
+auto RocketController::getInterpolatedRotation() const -> sf::Angle { return m_world.getInterpolatedRotation(m_body); }
+
+auto RocketController::getLinearVelocity() const -> sf::Vector2f { return m_world.getLinearVelocity(m_body); }
+
+auto RocketController::getAngularVelocity() const -> float { return m_world.getAngularVelocity(m_body); }
+
+auto RocketController::getBodyState() const -> BodyState { return m_world.getBodyState(m_body); }
+
+auto RocketController::getSweepStart() const -> sf::Vector2f { return m_sweepStart; }
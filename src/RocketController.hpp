@@ -0,0 +1,46 @@
+#pragma once
+
+#include "GameLevel.hpp"
+#include "InputState.hpp"
+#include "PhysicsWorld.hpp"
+
+#include <optional>
+
+// Gameplay rules for the rocket (thrust, gravity, planet & objective hits)
+// without any rendering or audio, shared by PlayerRocket and the headless
+// simulator.
+class RocketController {
+public:
+    struct Events {
+        bool collidedWithPlanet { false };
+        std::uint32_t objectivesCollected { 0 };
+    };
+
+    RocketController(PhysicsWorld& world, GameLevel& level);
+
+    auto update(const InputState& input) -> Events;
+
+    // Places the rocket back at the level start with no motion
+    void reset();
+    // Completely halts all forces and velocity, entirely for debug purposes
+    void halt();
+
+    auto getCollisionInfo() const -> std::optional<GameLevel::PlanetCollisionInfo>;
+    auto getPosition() const -> sf::Vector2f;
+    auto getRotation() const -> sf::Angle;
+    auto getInterpolatedPosition() const -> sf::Vector2f;
+    auto getInterpolatedRotation() const -> sf::Angle;
+    auto getLinearVelocity() const -> sf::Vector2f;
+    auto getAngularVelocity() const -> float;
+    auto getBodyState() const -> BodyState;
+    // Where the next update's collision sweep starts, see TrajectoryPredictor::Request
+    auto getSweepStart() const -> sf::Vector2f;
+
+private:
+    PhysicsWorld& m_world;
+    PhysicsWorld::BodyHandle m_body;
+    GameLevel& m_gameLevel;
+
+    std::optional<GameLevel::PlanetCollisionInfo> m_collisionInfo;
+    sf::Vector2f m_sweepStart; // Position before the current step
+};
@@ -0,0 +1,184 @@
+// Headless simulator, runs a level's physics & gameplay rules from a scripted
+// input stream with no window, rendering, audio or ImGui.
+//
+// Usage: impossible-rocket-sim <level.txt> [--input <script.txt>] [--ticks <count>] [--gravity-field <cell size>]
+//                              [--record <file>]
+//        impossible-rocket-sim --replay <file> [--gravity-field <cell size>]
+//
+// --gravity-field samples gravity from a baked field, cached next to the level.
+// --record writes the run as an input recording, --replay plays one back
+// (from the game or the simulator) exactly as it was recorded.
+
+#include "GameplayBlackboard.hpp"
+#include "InputRecording.hpp"
+#include "InputScript.hpp"
+#include "Simulation.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <string>
+
+constexpr std::uint64_t DEFAULT_TICK_COUNT { 120 * 60 };
+constexpr float MIN_GRAVITY_FIELD_CELL_SIZE { 1.0f };
+
+struct SimOptions {
+    std::filesystem::path levelPath;
+    std::optional<std::filesystem::path> inputPath;
+    std::optional<std::uint64_t> tickCount;
+    std::optional<float> gravityFieldCellSize;
+    std::optional<std::filesystem::path> recordPath;
+    std::optional<std::filesystem::path> replayPath;
+};
+
+SimOptions parse_options(int argc, char* argv[])
+{
+    SimOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg { argv[i] };
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--input" && hasValue) {
+            options.inputPath = argv[++i];
+        } else if (arg == "--ticks" && hasValue) {
+            options.tickCount = std::stoull(argv[++i]);
+        } else if (arg == "--gravity-field" && hasValue) {
+            const auto cellSize = std::stof(argv[++i]);
+            // The field's cell counts are cast from size / cellSize, so zero,
+            // negative, tiny & NaN sizes are all rejected here
+            if (!(cellSize >= MIN_GRAVITY_FIELD_CELL_SIZE && std::isfinite(cellSize)))
+                throw std::runtime_error(fmt::format(
+                    "The gravity field cell size must be at least {}, not {}", MIN_GRAVITY_FIELD_CELL_SIZE, cellSize));
+            options.gravityFieldCellSize = cellSize;
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (options.levelPath.empty() && arg[0] != '-') {
+            options.levelPath = arg;
+        } else {
+            throw std::runtime_error(fmt::format("Unknown argument {}", arg));
+        }
+    }
+
+    if (options.levelPath.empty() == !options.replayPath)
+        throw std::runtime_error("Usage: impossible-rocket-sim <level.txt> [--input <script.txt>] [--ticks <count>] "
+                                 "[--gravity-field <cell size>] [--record <file>]\n"
+                                 "       impossible-rocket-sim --replay <file> [--gravity-field <cell size>]");
+
+    return options;
+}
+
+bool is_in_play_area(const sf::Vector2f& position)
+{
+    const auto halfSize = bb::ROCKET_SIZE * 0.5f;
+    return position.x + halfSize.x >= 0.0f && position.y + halfSize.y >= 0.0f
+        && position.x - halfSize.x <= bb::PLAY_AREA_SIZE.x && position.y - halfSize.y <= bb::PLAY_AREA_SIZE.y;
+}
+
+// Plays the script with the simulator's own rules for resets, recording
+// every tick & reset if asked to
+void run_script(Simulation& sim, const SimOptions& options, InputRecording* recording)
+{
+    InputScript script;
+    if (options.inputPath)
+        script.loadFromFile(*options.inputPath);
+
+    const auto tickCount = options.tickCount.value_or(options.inputPath ? script.getTickCount() : DEFAULT_TICK_COUNT);
+
+    sim.level.loadLevel(options.levelPath);
+    sim.rocket.reset();
+    if (recording) {
+        recording->recordLevelLoad(options.levelPath);
+        recording->recordTimeStep(sim.timeStep);
+    }
+
+    const auto reset = [&] {
+        sim.reset();
+        if (recording)
+            recording->recordReset();
+    };
+
+    sf::Time outOfBoundsTime;
+    for (std::uint64_t tick = 0; tick < tickCount; ++tick) {
+        const auto input = script.getInput(tick);
+        if (recording)
+            recording->recordTick(input);
+
+        const auto events = sim.tick(input);
+        if (events.collidedWithPlanet) {
+            reset();
+            continue;
+        }
+
+        outOfBoundsTime = is_in_play_area(sim.rocket.getPosition()) ? sf::Time::Zero : outOfBoundsTime + sim.timeStep;
+        if (outOfBoundsTime >= sf::seconds(static_cast<float>(bb::MAX_OOB_TIME))) {
+            ++sim.stats.outOfBoundsResets;
+            outOfBoundsTime = sf::Time::Zero;
+            reset();
+            continue;
+        }
+
+        if (sim.level.isLevelComplete()) {
+            ++sim.stats.levelCompletions;
+            if (!sim.stats.firstCompletionTick)
+                sim.stats.firstCompletionTick = tick;
+            reset();
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try {
+        const auto options = parse_options(argc, argv);
+
+        Simulation sim;
+        if (options.gravityFieldCellSize) {
+            sim.level.setGravityFieldEnabled(true);
+            sim.level.setGravityFieldCellSize(*options.gravityFieldCellSize);
+            sim.level.setGravityFieldCacheEnabled(true);
+        }
+
+        InputRecording recording;
+        const auto start = std::chrono::steady_clock::now();
+        if (options.replayPath) {
+            recording.loadFromFile(*options.replayPath);
+            run_replay(sim, recording);
+        } else {
+            spdlog::info("Level {}", options.levelPath.string());
+            run_script(sim, options, options.recordPath ? &recording : nullptr);
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (options.recordPath && !options.replayPath) {
+            recording.saveToFile(*options.recordPath);
+            spdlog::info("Recorded {} ticks to {}", recording.getTickCount(), options.recordPath->string());
+        }
+
+        const auto& stats = sim.stats;
+        const auto ticksPerSecond = elapsed > 0.0 ? static_cast<double>(stats.ticks) / elapsed : 0.0;
+        spdlog::info("Ticks {} ({:.2f}s simulated) in {:.3f}ms, {:.0f} ticks/s",
+                     stats.ticks,
+                     static_cast<double>(stats.ticks) * static_cast<double>(sim.timeStep.asSeconds()),
+                     elapsed * 1000.0,
+                     ticksPerSecond);
+        spdlog::info("Planet collisions {}, out of bounds resets {}, objectives collected {}",
+                     stats.planetCollisions,
+                     stats.outOfBoundsResets,
+                     stats.objectivesCollected);
+        if (stats.firstCompletionTick)
+            spdlog::info(
+                "Level completed {} times, first at tick {}", stats.levelCompletions, *stats.firstCompletionTick);
+        else
+            spdlog::info("Level not completed");
+        spdlog::info("Trajectory hash {:016x}", stats.trajectoryHash);
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
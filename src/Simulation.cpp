@@ -0,0 +1,85 @@
+#include "Simulation.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+Simulation::Simulation()
+    : rocket(world, level)
+{
+}
+
+auto Simulation::tick(const InputState& input) -> RocketController::Events
+{
+    world.step(timeStep, timeStep);
+    level.update(timeStep);
+
+    // A crashed rocket reports the collision every tick until it's reset
+    const bool hadCollided = rocket.getCollisionInfo().has_value();
+    const auto events = rocket.update(input);
+    stats.objectivesCollected += events.objectivesCollected;
+    stats.planetCollisions += events.collidedWithPlanet && !hadCollided ? 1 : 0;
+    ++stats.ticks;
+
+    const auto position = rocket.getPosition();
+    std::uint8_t bytes[sizeof(position)];
+    std::memcpy(bytes, &position, sizeof(position));
+    for (const auto byte : bytes) {
+        stats.trajectoryHash ^= byte;
+        stats.trajectoryHash *= 1099511628211ull;
+    }
+    return events;
+}
+
+void Simulation::reset()
+{
+    level.resetLevel();
+    rocket.reset();
+}
+
+void run_replay(Simulation& sim, const InputRecording& recording, const ReplayTickCallback& onTick)
+{
+    bool wasComplete = true;
+    for (const auto& e : recording.getEvents()) {
+        switch (e.type) {
+        case InputRecording::EventType::Input:
+            for (std::uint32_t i = 0; i < e.tickCount; ++i) {
+                const auto events = sim.tick(e.input);
+                if (onTick)
+                    onTick(e.input, events);
+                const bool isComplete = sim.level.isLevelComplete();
+                if (isComplete && !wasComplete) {
+                    ++sim.stats.levelCompletions;
+                    if (!sim.stats.firstCompletionTick)
+                        sim.stats.firstCompletionTick = sim.stats.ticks - 1;
+                }
+                wasComplete = isComplete;
+            }
+            break;
+        case InputRecording::EventType::Reset:
+            sim.reset();
+            wasComplete = sim.level.isLevelComplete();
+            break;
+        case InputRecording::EventType::LoadLevel:
+            if (e.level != GameLevel::Levels::MAX_LEVEL)
+                sim.level.loadLevel(e.level);
+            else
+                sim.level.loadLevel(e.levelPath);
+            sim.rocket.reset();
+            wasComplete = sim.level.isLevelComplete();
+            spdlog::info("Level {}",
+                         e.level != GameLevel::Levels::MAX_LEVEL ? GameLevel::getLevelPath(e.level).string()
+                                                                 : e.levelPath);
+            break;
+        case InputRecording::EventType::TimeStep:
+            sim.timeStep = e.timeStep;
+            break;
+        case InputRecording::EventType::Halt:
+            sim.rocket.halt();
+            break;
+        default:
+            assert(false);
+            break;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "GameLevel.hpp"
+#include "GameplayBlackboard.hpp"
+#include "InputRecording.hpp"
+#include "InputState.hpp"
+#include "PhysicsWorld.hpp"
+#include "RocketController.hpp"
+
+#include <SFML/System/Time.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+struct SimStats {
+    std::uint64_t ticks { 0 };
+    std::uint32_t planetCollisions { 0 };
+    std::uint32_t outOfBoundsResets { 0 };
+    std::uint32_t objectivesCollected { 0 };
+    std::uint32_t levelCompletions { 0 };
+    std::optional<std::uint64_t> firstCompletionTick;
+    // Hash of the rocket position after every tick, equal hashes mean
+    // identical trajectories
+    std::uint64_t trajectoryHash { 14695981039346656037ull };
+};
+
+// The fixed-step simulation with no window, rendering, audio or ImGui, as
+// the headless simulator & replay tests run it
+struct Simulation {
+    Simulation();
+
+    auto tick(const InputState& input) -> RocketController::Events;
+    void reset();
+
+    PhysicsWorld world;
+    GameLevel level;
+    RocketController rocket;
+    sf::Time timeStep { bb::FIXED_TIME_STEP };
+    SimStats stats;
+};
+
+// Called after every replayed tick with its input & what happened
+using ReplayTickCallback = std::function<void(const InputState& input, const RocketController::Events& events)>;
+
+// Applies the recorded events in order, every reset comes from the recording
+void run_replay(Simulation& sim, const InputRecording& recording, const ReplayTickCallback& onTick = {});
@@ -9,15 +9,22 @@ std::size_t ToSizeT(T value)
 
 SoundCentral::SoundCentral()
 {
+    // Everything is requested up front so it all decodes in parallel
     auto& ah = AssetHolder::get();
+    const auto planetCollision = ah.loadSoundBuffer(AssetId::Sounds_Planet_Collide);
+    const auto levelStart = ah.loadSoundBuffer(AssetId::Sounds_Level_Reset);
+    const auto menuItemHover = ah.loadSoundBuffer(AssetId::Sounds_Menu_Hover);
+    const auto objectiveCollected = ah.loadSoundBuffer(AssetId::Sounds_Objective_Collect);
+    const auto mainGameTheme = ah.loadMusic(AssetId::Sounds_Game_Theme_Music);
+
     // Sfx
-    m_soundEffects[ToSizeT(SoundEffectTypes::PlanetCollision)].setBuffer(
-        *ah.getSoundBuffer("bin/sounds/planet_collide.wav"));
-    m_soundEffects[ToSizeT(SoundEffectTypes::LevelStart)].setBuffer(*ah.getSoundBuffer("bin/sounds/level_reset.wav"));
-    m_soundEffects[ToSizeT(SoundEffectTypes::MenuItemHover)].setBuffer(*ah.getSoundBuffer("bin/sounds/menu_hover.wav"));
+    m_soundEffects[ToSizeT(SoundEffectTypes::PlanetCollision)].setBuffer(*planetCollision.get());
+    m_soundEffects[ToSizeT(SoundEffectTypes::LevelStart)].setBuffer(*levelStart.get());
+    m_soundEffects[ToSizeT(SoundEffectTypes::MenuItemHover)].setBuffer(*menuItemHover.get());
+    m_soundEffects[ToSizeT(SoundEffectTypes::ObjectiveCollected)].setBuffer(*objectiveCollected.get());
 
     // Music
-    m_musicStreams[ToSizeT(MusicTypes::MainGameTheme)] = ah.getMusic("bin/sounds/game_theme_music.mp3");
+    m_musicStreams[ToSizeT(MusicTypes::MainGameTheme)] = mainGameTheme.get();
     m_musicStreams[ToSizeT(MusicTypes::MainGameTheme)]->setLoop(true);
 }
 
@@ -6,7 +6,7 @@
 
 class SoundCentral {
 public:
-    enum class SoundEffectTypes { PlanetCollision = 0, LevelStart, MenuItemHover, MAX_SFX };
+    enum class SoundEffectTypes { PlanetCollision = 0, LevelStart, MenuItemHover, ObjectiveCollected, MAX_SFX };
     enum class MusicTypes { MainGameTheme = 0, MAX_MUSIC };
 
     SoundCentral();
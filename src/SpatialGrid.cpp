@@ -0,0 +1,71 @@
+#include "SpatialGrid.hpp"
+
+#include <cmath>
+#include <limits>
+
+// Keeps the cell count proportional to the item count for levels that are
+// sparse compared to their extent
+constexpr std::uint32_t MAX_CELLS_PER_ITEM { 4 };
+
+void SpatialGrid::build(const std::vector<Circle>& circles)
+{
+    clear();
+    if (circles.empty())
+        return;
+
+    sf::Vector2f min { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    sf::Vector2f max { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+    float radiusSum = 0.0f;
+    for (const auto& c : circles) {
+        min.x = std::min(min.x, c.position.x - c.radius);
+        min.y = std::min(min.y, c.position.y - c.radius);
+        max.x = std::max(max.x, c.position.x + c.radius);
+        max.y = std::max(max.y, c.position.y + c.radius);
+        radiusSum += c.radius;
+    }
+
+    // Cells about the size of an average circle, so most circles cover
+    // only a handful of cells
+    const auto size = max - min;
+    const auto cellLimit = static_cast<float>(circles.size() * MAX_CELLS_PER_ITEM);
+    m_cellSize = std::max(2.0f * radiusSum / static_cast<float>(circles.size()), 1.0f);
+    const auto cellCount = std::ceil(size.x / m_cellSize) * std::ceil(size.y / m_cellSize);
+    if (cellCount > cellLimit)
+        m_cellSize *= std::sqrt(cellCount / cellLimit);
+
+    m_origin = min;
+    m_columns = std::max(static_cast<std::uint32_t>(std::ceil(size.x / m_cellSize)), 1u);
+    m_rows = std::max(static_cast<std::uint32_t>(std::ceil(size.y / m_cellSize)), 1u);
+
+    // Count the items per cell, turn the counts into offsets then fill
+    m_cellStart.assign(m_columns * m_rows + 1, 0);
+    const auto forEachCell = [this](const Circle& c, auto&& func) {
+        const auto minColumn = toCell(c.position.x - c.radius, m_origin.x, m_columns);
+        const auto maxColumn = toCell(c.position.x + c.radius, m_origin.x, m_columns);
+        const auto minRow = toCell(c.position.y - c.radius, m_origin.y, m_rows);
+        const auto maxRow = toCell(c.position.y + c.radius, m_origin.y, m_rows);
+        for (auto row = minRow; row <= maxRow; ++row)
+            for (auto column = minColumn; column <= maxColumn; ++column)
+                func(row * m_columns + column);
+    };
+
+    for (const auto& c : circles)
+        forEachCell(c, [this](std::uint32_t cell) { ++m_cellStart[cell + 1]; });
+
+    for (std::size_t i = 1; i < m_cellStart.size(); ++i)
+        m_cellStart[i] += m_cellStart[i - 1];
+
+    m_items.resize(m_cellStart.back());
+    auto fill = m_cellStart;
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(circles.size()); ++i)
+        forEachCell(circles[i], [this, &fill, i](std::uint32_t cell) { m_items[fill[cell]++] = i; });
+}
+
+void SpatialGrid::clear()
+{
+    m_columns = m_rows = 0;
+    m_cellStart.clear();
+    m_items.clear();
+}
+
+auto SpatialGrid::getCellSize() const -> float { return m_cellSize; }
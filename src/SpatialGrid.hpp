@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over a fixed set of circles, built once and then queried for
+// the circles that may overlap another circle. Cells store item indices in
+// one flat array (offsets per cell) so a query touches only a few small
+// contiguous ranges.
+class SpatialGrid {
+public:
+    struct Circle {
+        sf::Vector2f position;
+        float radius { 0.0f };
+    };
+
+    void build(const std::vector<Circle>& circles);
+    void clear();
+
+    // Calls visit(index) for every circle sharing a cell with the query
+    // circle, in ascending index order within a cell. A circle spanning
+    // several cells can be visited more than once. Returning true from
+    // visit stops the query early.
+    template <typename Visitor>
+    void query(const sf::Vector2f& position, float radius, Visitor&& visit) const;
+
+    auto getCellSize() const -> float;
+
+private:
+    auto toCell(float coordinate, float origin, std::uint32_t cellCount) const -> std::uint32_t;
+
+    sf::Vector2f m_origin;
+    float m_cellSize { 1.0f };
+    std::uint32_t m_columns { 0 };
+    std::uint32_t m_rows { 0 };
+    std::vector<std::uint32_t> m_cellStart; // m_columns * m_rows + 1 offsets into m_items
+    std::vector<std::uint32_t> m_items;
+};
+
+template <typename Visitor>
+void SpatialGrid::query(const sf::Vector2f& position, float radius, Visitor&& visit) const
+{
+    if (m_items.empty())
+        return;
+
+    const auto extent = sf::Vector2f { static_cast<float>(m_columns), static_cast<float>(m_rows) } * m_cellSize;
+    if (position.x + radius < m_origin.x || position.y + radius < m_origin.y
+        || position.x - radius > m_origin.x + extent.x || position.y - radius > m_origin.y + extent.y)
+        return;
+
+    const auto minColumn = toCell(position.x - radius, m_origin.x, m_columns);
+    const auto maxColumn = toCell(position.x + radius, m_origin.x, m_columns);
+    const auto minRow = toCell(position.y - radius, m_origin.y, m_rows);
+    const auto maxRow = toCell(position.y + radius, m_origin.y, m_rows);
+
+    for (auto row = minRow; row <= maxRow; ++row) {
+        for (auto column = minColumn; column <= maxColumn; ++column) {
+            const auto cell = row * m_columns + column;
+            for (auto i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                if (visit(m_items[i]))
+                    return;
+            }
+        }
+    }
+}
+
+inline auto SpatialGrid::toCell(float coordinate, float origin, std::uint32_t cellCount) const -> std::uint32_t
+{
+    const auto cell = std::clamp((coordinate - origin) / m_cellSize, 0.0f, static_cast<float>(cellCount - 1));
+    return static_cast<std::uint32_t>(cell);
+}
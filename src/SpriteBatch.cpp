@@ -0,0 +1,115 @@
+#include "SpriteBatch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+
+void SpriteBatch::add(const sf::RectangleShape& shape)
+{
+    const auto& transform = shape.getTransform();
+    const auto size = shape.getSize();
+    const auto textureRect = sf::FloatRect(shape.getTextureRect());
+    const auto colour = shape.getFillColor();
+
+    const std::array<sf::Vector2f, 4> corners { transform.transformPoint({ 0.0f, 0.0f }),
+                                                transform.transformPoint({ size.x, 0.0f }),
+                                                transform.transformPoint(size),
+                                                transform.transformPoint({ 0.0f, size.y }) };
+    const auto texTopLeft = textureRect.getPosition();
+    const auto texBottomRight = textureRect.getPosition() + textureRect.getSize();
+    const std::array<sf::Vector2f, 4> texCoords { texTopLeft,
+                                                  sf::Vector2f { texBottomRight.x, texTopLeft.y },
+                                                  texBottomRight,
+                                                  sf::Vector2f { texTopLeft.x, texBottomRight.y } };
+
+    for (const std::size_t corner : { 0u, 1u, 2u, 2u, 3u, 0u })
+        m_vertices.push_back({ corners[corner], colour, texCoords[corner] });
+    m_textures.push_back(shape.getTexture());
+}
+
+void SpriteBatch::add(const sf::Drawable& drawable, std::size_t vertexCount)
+{
+    m_drawables.push_back({ &drawable, vertexCount, m_textures.size() });
+}
+
+void SpriteBatch::addBarrier()
+{
+    // Only needed when quads have been queued since the last split
+    const auto lastEnd = m_drawables.empty() ? 0 : m_drawables.back().quadEnd;
+    if (m_textures.size() > lastEnd)
+        m_drawables.push_back({ nullptr, 0, m_textures.size() });
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target, const sf::RenderStates& states)
+{
+    m_stats = {};
+    m_stats.quadCount = m_textures.size();
+
+    std::size_t quadBegin = 0;
+    for (const auto& d : m_drawables) {
+        drawQuads(target, states, quadBegin, d.quadEnd);
+        quadBegin = d.quadEnd;
+        if (!d.drawable)
+            continue;
+
+        target.draw(*d.drawable, states);
+        ++m_stats.drawCalls;
+        m_stats.vertexCount += d.vertexCount;
+    }
+    drawQuads(target, states, quadBegin, m_textures.size());
+
+    m_vertices.clear();
+    m_textures.clear();
+    m_drawables.clear();
+}
+
+auto SpriteBatch::getStats() const -> const Stats& { return m_stats; }
+
+void SpriteBatch::drawQuads(sf::RenderTarget& target,
+                            const sf::RenderStates& states,
+                            std::size_t begin,
+                            std::size_t end)
+{
+    if (end <= begin)
+        return;
+
+    // Usually every quad in the run shares the atlas, then the queued
+    // vertices are drawn as they are
+    const sf::Vertex* vertices = &m_vertices[begin * 6];
+    const bool isOneTexture
+        = std::all_of(m_textures.begin() + static_cast<std::ptrdiff_t>(begin),
+                      m_textures.begin() + static_cast<std::ptrdiff_t>(end),
+                      [this, begin](const sf::Texture* texture) { return texture == m_textures[begin]; });
+    if (!isOneTexture) {
+        // Queue order breaks ties, so quads sharing a texture keep their order
+        m_order.clear();
+        for (auto i = begin; i < end; ++i)
+            m_order.emplace_back(m_textures[i], i);
+        std::sort(m_order.begin(), m_order.end(), [](const auto& a, const auto& b) {
+            return std::less<const sf::Texture*>()(a.first, b.first) || (a.first == b.first && a.second < b.second);
+        });
+
+        m_sortedVertices.clear();
+        for (const auto& entry : m_order) {
+            const auto first = m_vertices.begin() + static_cast<std::ptrdiff_t>(entry.second * 6);
+            m_sortedVertices.insert(m_sortedVertices.end(), first, first + 6);
+        }
+        vertices = m_sortedVertices.data();
+    }
+
+    auto statesCopy = states;
+    std::size_t runBegin = 0;
+    const auto quadCount = end - begin;
+    while (runBegin < quadCount) {
+        const auto texture = isOneTexture ? m_textures[begin] : m_order[runBegin].first;
+        auto runEnd = isOneTexture ? quadCount : runBegin + 1;
+        while (runEnd < quadCount && m_order[runEnd].first == texture)
+            ++runEnd;
+
+        statesCopy.texture = texture;
+        target.draw(vertices + runBegin * 6, (runEnd - runBegin) * 6, sf::PrimitiveType::Triangles, statesCopy);
+        ++m_stats.drawCalls;
+        m_stats.vertexCount += (runEnd - runBegin) * 6;
+        runBegin = runEnd;
+    }
+}
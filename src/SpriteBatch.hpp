@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Collects a frame's textured quads into one vertex stream & draws them with
+// one call per texture. Anything that isn't a quad is added as a drawable &
+// drawn in order. The quads queued between two drawables or barriers are
+// drawn sorted by texture, so only quads whose relative order doesn't matter
+// (or that share a texture, like sprites in one atlas) should be queued
+// together. Buffers are kept between frames, a steady scene doesn't allocate.
+class SpriteBatch {
+public:
+    struct Stats {
+        std::size_t drawCalls { 0 };
+        std::size_t vertexCount { 0 };
+        std::size_t quadCount { 0 };
+    };
+
+    // The shape's fill, texture rect & transform, outlines aren't drawn
+    void add(const sf::RectangleShape& shape);
+    // Drawn as is, vertexCount is only used for the stats
+    void add(const sf::Drawable& drawable, std::size_t vertexCount);
+    // Quads queued before the barrier are drawn before any queued after it
+    void addBarrier();
+
+    // Draws & clears everything queued since the last flush
+    void flush(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Counted over the last flush, drawables count as one call each
+    auto getStats() const -> const Stats&;
+
+private:
+    struct Drawable {
+        const sf::Drawable* drawable { nullptr }; // Null for a barrier
+        std::size_t vertexCount { 0 };
+        std::size_t quadEnd { 0 }; // Quads queued before the drawable
+    };
+
+    void drawQuads(sf::RenderTarget& target, const sf::RenderStates& states, std::size_t begin, std::size_t end);
+
+    std::vector<sf::Vertex> m_vertices; // Six per quad, in the order queued
+    std::vector<const sf::Texture*> m_textures; // One per quad
+    std::vector<Drawable> m_drawables;
+    // Scratch for quad runs that mix textures
+    std::vector<std::pair<const sf::Texture*, std::size_t>> m_order;
+    std::vector<sf::Vertex> m_sortedVertices;
+    Stats m_stats;
+};
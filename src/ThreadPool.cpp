@@ -0,0 +1,118 @@
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0) {
+        const auto hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+        threadCount = std::max<std::size_t>(hardwareThreads, 2) - 1;
+    }
+
+    m_threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        m_threads.emplace_back([this] { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+auto ThreadPool::getThreadCount() const -> std::size_t { return m_threads.size(); }
+
+void ThreadPool::workerLoop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            ForJob* job = nullptr;
+            m_condition.wait(lock, [this, &job] {
+                job = findForJob();
+                return m_isStopping || job || !m_tasks.empty();
+            });
+
+            // Joining a parallelFor comes first, its caller is waiting on it
+            if (job) {
+                ++job->helperCount;
+                lock.unlock();
+                runChunks(*job);
+                lock.lock();
+                // The job is gone as soon as the lock is released
+                if (--job->helperCount == 0)
+                    m_forJobDone.notify_all();
+                continue;
+            }
+
+            // Queued tasks are still run when stopping, someone may be waiting on them
+            if (m_tasks.empty())
+                return;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::runForJob(ForJob& job)
+{
+    // Published for idle workers to join, a job with one chunk or no free
+    // slot runs on the calling thread alone
+    bool isPublished = false;
+    if (job.chunkCount > 1 && !m_threads.empty()) {
+        std::lock_guard lock(m_mutex);
+        const auto slot = std::find(m_forJobs.begin(), m_forJobs.end(), nullptr);
+        if (slot != m_forJobs.end()) {
+            *slot = &job;
+            isPublished = true;
+        }
+    }
+    if (isPublished) {
+        const auto helperCount = std::min(job.chunkCount - 1, m_threads.size());
+        for (std::size_t i = 0; i < helperCount; ++i)
+            m_condition.notify_one();
+    }
+
+    runChunks(job);
+
+    // Once unpublished no more helpers join, wait for the ones still running
+    if (isPublished) {
+        std::unique_lock lock(m_mutex);
+        *std::find(m_forJobs.begin(), m_forJobs.end(), &job) = nullptr;
+        m_forJobDone.wait(lock, [&job] { return job.helperCount == 0; });
+    }
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
+
+void ThreadPool::runChunks(ForJob& job)
+{
+    try {
+        for (auto chunk = job.nextChunk++; chunk < job.chunkCount; chunk = job.nextChunk++) {
+            const auto begin = chunk * job.chunkSize;
+            job.runChunk(job.func, begin, std::min(begin + job.chunkSize, job.count));
+        }
+    } catch (...) {
+        // The chunks left are skipped
+        job.nextChunk = job.chunkCount;
+        std::lock_guard lock(m_mutex);
+        if (!job.error)
+            job.error = std::current_exception();
+    }
+}
+
+auto ThreadPool::findForJob() const -> ForJob*
+{
+    for (auto* job : m_forJobs) {
+        if (job && job->nextChunk < job->chunkCount)
+            return job;
+    }
+    return nullptr;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads shared by anything that wants to spread work
+// across cores. Tasks must not wait on other tasks in the pool or the pool
+// can run out of free workers. parallelFor doesn't queue tasks, so it's safe
+// to call from anywhere including a task.
+class ThreadPool {
+public:
+    static ThreadPool& get()
+    {
+        static ThreadPool& instance = *new ThreadPool();
+        return instance;
+    }
+
+    // Zero picks one worker per hardware thread, minus the calling thread
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename Func>
+    auto submit(Func&& func) -> std::future<std::invoke_result_t<std::decay_t<Func>>>;
+
+    // Runs func(begin, end) over [0, count) in chunks of chunkSize, on the
+    // calling thread & any idle workers, returning once every chunk is done.
+    // Nothing is allocated, and workers busy with tasks are never waited on,
+    // the calling thread runs whatever chunks nobody else has taken.
+    template <typename Func>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Func&& func);
+
+    auto getThreadCount() const -> std::size_t;
+
+private:
+    // A parallelFor in progress, lives on the calling thread's stack
+    struct ForJob {
+        void (*runChunk)(void* func, std::size_t begin, std::size_t end) { nullptr };
+        void* func { nullptr };
+        std::size_t count { 0 };
+        std::size_t chunkSize { 0 };
+        std::size_t chunkCount { 0 };
+        std::atomic<std::size_t> nextChunk { 0 };
+        std::size_t helperCount { 0 }; // Workers running its chunks, guarded by m_mutex
+        std::exception_ptr error; // The first chunk to throw, guarded by m_mutex
+    };
+
+    // parallelFors running at once that workers can join, any more run on
+    // their calling thread alone
+    static constexpr std::size_t MAX_FOR_JOBS { 8 };
+
+    void workerLoop();
+    void runForJob(ForJob& job);
+    void runChunks(ForJob& job);
+    // A published job with chunks left, call with m_mutex held
+    auto findForJob() const -> ForJob*;
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::array<ForJob*, MAX_FOR_JOBS> m_forJobs {};
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_forJobDone;
+    bool m_isStopping { false };
+};
+
+template <typename Func>
+auto ThreadPool::submit(Func&& func) -> std::future<std::invoke_result_t<std::decay_t<Func>>>
+{
+    using Result = std::invoke_result_t<std::decay_t<Func>>;
+    // std::function needs a copyable target, packaged_task is move only
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+    auto future = task->get_future();
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.emplace_back([task] { (*task)(); });
+    }
+    m_condition.notify_one();
+    return future;
+}
+
+template <typename Func>
+void ThreadPool::parallelFor(std::size_t count, std::size_t chunkSize, Func&& func)
+{
+    if (count == 0)
+        return;
+
+    using FuncType = std::remove_reference_t<Func>;
+    ForJob job;
+    job.runChunk = [](void* f, std::size_t begin, std::size_t end) { (*static_cast<FuncType*>(f))(begin, end); };
+    job.func = const_cast<void*>(static_cast<const void*>(std::addressof(func)));
+    job.count = count;
+    job.chunkSize = std::max<std::size_t>(chunkSize, 1);
+    job.chunkCount = (count + job.chunkSize - 1) / job.chunkSize;
+    runForJob(job);
+}
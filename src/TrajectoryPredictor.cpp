@@ -0,0 +1,87 @@
+#include "TrajectoryPredictor.hpp"
+#include "GameplayBlackboard.hpp"
+
+#include <cassert>
+
+TrajectoryPredictor::TrajectoryPredictor(const GameLevel& level, ThreadPool& pool)
+    : m_gameLevel(level)
+    , m_pool(pool)
+{
+}
+
+void TrajectoryPredictor::predict(const std::vector<Request>& requests,
+                                  const Settings& settings,
+                                  std::vector<Trajectory>& results)
+{
+    // Results are reused between calls to keep their point buffers
+    results.resize(requests.size());
+    m_pool.parallelFor(requests.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i)
+            predictInto(requests[i], settings, results[i]);
+    });
+}
+
+auto TrajectoryPredictor::predictOne(const Request& request, const Settings& settings) const -> Trajectory
+{
+    Trajectory trajectory;
+    predictInto(request, settings, trajectory);
+    return trajectory;
+}
+
+void TrajectoryPredictor::predictInto(const Request& request, const Settings& settings, Trajectory& trajectory) const
+{
+    assert(settings.sampleInterval > 0);
+    trajectory.points.clear();
+    trajectory.planetHit.reset();
+    trajectory.objectiveHit.reset();
+
+    // Mirrors PhysicsWorld::addBody
+    const float invMass = 1.0f / bb::ROCKET_MASS;
+    const float invInertia = 1.0f / bb::ROCKET_INERTIA;
+    const float radius = bb::ROCKET_SIZE.x / 2.0f;
+    const float timeStep = settings.timeStep.asSeconds();
+
+    auto state = request.state;
+    auto previousPosition = request.sweepStart;
+    trajectory.points.push_back(state.position);
+    for (std::uint32_t tick = 0; tick < settings.tickCount; ++tick) {
+        const auto input = tick < request.inputs.size() ? request.inputs[tick] : InputState {};
+
+        // RocketController::update, forces accumulate from zero like the
+        // body's force arrays after a step
+        const auto direction = sf::Vector2f(1.0f, sf::degrees(state.rotation));
+        sf::Vector2f force;
+        float torque = 0.0f;
+        if (input.linear_thrust != 0.0f)
+            force += direction * (bb::THRUST_FORCE * input.linear_thrust);
+        if (input.angular_thrust != 0.0f)
+            torque += bb::TORQUE_MAG * input.angular_thrust;
+
+        if (const auto result = m_gameLevel.doesCollideWithPlanet(previousPosition, state.position, radius)) {
+            trajectory.planetHit = PlanetHit { tick, *result };
+            state.position = result->position;
+        }
+
+        // Checked up to where a collision stopped the rocket, like the controller
+        if (!trajectory.objectiveHit) {
+            if (const auto objective = m_gameLevel.findObjectiveIntersection(previousPosition, state.position, radius))
+                trajectory.objectiveHit = ObjectiveHit { tick, *objective };
+        }
+
+        // A collision deactivates the body, nothing moves after it
+        if (trajectory.planetHit)
+            break;
+
+        force += m_gameLevel.getSummedForce(state.position, bb::ROCKET_MASS);
+
+        // PhysicsWorld::step
+        previousPosition = state.position;
+        integrate_body(state, force, torque, invMass, invInertia, timeStep);
+        if ((tick + 1) % settings.sampleInterval == 0)
+            trajectory.points.push_back(state.position);
+    }
+
+    if (trajectory.points.back() != state.position)
+        trajectory.points.push_back(state.position);
+    trajectory.finalState = state;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "GameLevel.hpp"
+#include "InputState.hpp"
+#include "PhysicsKernels.hpp"
+#include "ThreadPool.hpp"
+
+#include <SFML/System/Time.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Integrates rocket states forward against a level using exactly the same
+// rules and operation order as RocketController & PhysicsWorld, so a
+// prediction matches gameplay bit for bit given the same inputs. Predictions
+// run in parallel on the thread pool, the level must not change meanwhile.
+class TrajectoryPredictor {
+public:
+    struct Request {
+        // Taken as the state right after a physics step, so the first tick
+        // runs the rocket rules before integrating, like the tick callback
+        BodyState state;
+        // Where the first tick's collision sweep starts, the controller's
+        // getSweepStart, so a hit in the step just taken isn't missed
+        sf::Vector2f sweepStart;
+        // One input per tick, zero input once they run out
+        std::vector<InputState> inputs;
+    };
+
+    struct Settings {
+        std::uint32_t tickCount { 240 };
+        // Every nth tick is added to the points
+        std::uint32_t sampleInterval { 4 };
+        sf::Time timeStep;
+    };
+
+    struct PlanetHit {
+        std::uint32_t tick { 0 };
+        GameLevel::PlanetCollisionInfo info;
+    };
+
+    struct ObjectiveHit {
+        std::uint32_t tick { 0 };
+        std::size_t objective { 0 };
+    };
+
+    struct Trajectory {
+        std::vector<sf::Vector2f> points;
+        std::optional<PlanetHit> planetHit;
+        std::optional<ObjectiveHit> objectiveHit;
+        BodyState finalState;
+    };
+
+    TrajectoryPredictor(const GameLevel& level, ThreadPool& pool);
+
+    void predict(const std::vector<Request>& requests, const Settings& settings, std::vector<Trajectory>& results);
+    // Single prediction on the calling thread
+    auto predictOne(const Request& request, const Settings& settings) const -> Trajectory;
+
+private:
+    void predictInto(const Request& request, const Settings& settings, Trajectory& trajectory) const;
+
+    const GameLevel& m_gameLevel;
+    ThreadPool& m_pool;
+};
@@ -0,0 +1,122 @@
+// Generates AssetIds.hpp, an enum with one id per asset & a constexpr table
+// of their paths, so the game looks assets up by array index rather than by
+// hashing a path string. Ids are named after the path without bin/ or the
+// extension, bin/textures/planet.png is AssetId::Textures_Planet.
+//
+// impossible-rocket-asset-ids <output header> <asset>...
+// Asset paths are stored in the table as given.
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto make_id_name(const std::string& assetPath) -> std::string
+{
+    auto relative = std::filesystem::path(assetPath).lexically_relative("bin");
+    if (relative.empty() || *relative.begin() == "..")
+        relative = assetPath;
+    relative.replace_extension();
+
+    // Words are split on anything that can't go in an identifier, each is
+    // capitalised & they're joined with underscores
+    std::string name;
+    bool isWordStart = true;
+    for (const char c : relative.generic_string()) {
+        if (std::isalnum(static_cast<unsigned char>(c)) == 0) {
+            isWordStart = true;
+            continue;
+        }
+        if (isWordStart && !name.empty())
+            name += '_';
+        name += isWordStart ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        isWordStart = false;
+    }
+
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front())) != 0)
+        throw std::runtime_error(fmt::format("Unable to name an id for {}", assetPath));
+    return name;
+}
+
+void write_header(const std::filesystem::path& path,
+                  const std::vector<std::string>& assetPaths,
+                  const std::vector<std::string>& names)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to write {}", path.string()));
+
+    file << "// Generated by impossible-rocket-asset-ids, don't edit\n"
+            "#pragma once\n\n"
+            "#include <array>\n"
+            "#include <cstddef>\n"
+            "#include <cstdint>\n"
+            "#include <optional>\n"
+            "#include <string_view>\n\n"
+            "enum class AssetId : std::uint16_t {\n";
+    for (const auto& name : names)
+        file << "    " << name << ",\n";
+    file << "    MAX_ASSET\n"
+            "};\n\n"
+            "constexpr auto ASSET_COUNT { static_cast<std::size_t>(AssetId::MAX_ASSET) };\n\n"
+            "// Indexed by AssetId\n";
+    file << "constexpr std::array<std::string_view, ASSET_COUNT> ASSET_PATHS { {\n";
+    for (const auto& assetPath : assetPaths)
+        file << fmt::format("    \"{}\",\n", assetPath);
+    file << "} };\n\n"
+            "constexpr auto get_asset_path(AssetId id) -> std::string_view\n"
+            "{\n"
+            "    return ASSET_PATHS[static_cast<std::size_t>(id)];\n"
+            "}\n\n"
+            "constexpr auto find_asset(std::string_view path) -> std::optional<AssetId>\n"
+            "{\n"
+            "    for (std::size_t i = 0; i < ASSET_PATHS.size(); ++i) {\n"
+            "        if (ASSET_PATHS[i] == path)\n"
+            "            return static_cast<AssetId>(i);\n"
+            "    }\n"
+            "    return {};\n"
+            "}\n";
+
+    if (!file.good())
+        throw std::runtime_error(fmt::format("Unable to write {}", path.string()));
+}
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 3)
+            throw std::runtime_error("Usage: impossible-rocket-asset-ids <output header> <asset>...");
+
+        const std::filesystem::path headerPath { argv[1] };
+        std::vector<std::string> assetPaths(argv + 2, argv + argc);
+        // Sorted so the ids don't depend on the order the build lists them in
+        std::sort(assetPaths.begin(), assetPaths.end());
+        assetPaths.erase(std::unique(assetPaths.begin(), assetPaths.end()), assetPaths.end());
+
+        std::vector<std::string> names;
+        for (const auto& assetPath : assetPaths) {
+            names.push_back(make_id_name(assetPath));
+            const auto duplicate = std::find(names.begin(), names.end() - 1, names.back());
+            if (duplicate != names.end() - 1) {
+                throw std::runtime_error(fmt::format("{} and {} would both be AssetId::{}",
+                                                     assetPaths[static_cast<std::size_t>(duplicate - names.begin())],
+                                                     assetPath,
+                                                     names.back()));
+            }
+        }
+
+        std::filesystem::create_directories(headerPath.parent_path());
+        write_header(headerPath, assetPaths, names);
+        spdlog::info("Generated ids for {} assets", assetPaths.size());
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
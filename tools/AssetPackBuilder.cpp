@@ -0,0 +1,35 @@
+// Packs assets into the single file AssetHolder maps at startup, see
+// AssetPack. Assets are stored under their paths as given, so they're
+// found by the same paths the game would open them with.
+//
+// impossible-rocket-asset-pack <output pack> <asset>...
+
+#include "AssetPack.hpp"
+
+#include <exception>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 3)
+            throw std::runtime_error("Usage: impossible-rocket-asset-pack <output pack> <asset>...");
+
+        const std::filesystem::path packPath { argv[1] };
+        const std::vector<std::string> assetPaths(argv + 2, argv + argc);
+        AssetPack::write(packPath, assetPaths);
+        spdlog::info("Packed {} assets into {} ({} bytes)",
+                     assetPaths.size(),
+                     packPath.string(),
+                     std::filesystem::file_size(packPath));
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+// Packs the sprite textures into one atlas at build time. Writes a header
+// with a constexpr table of where each image ended up & a source file with
+// the atlas pixels, so the game uploads a single texture without decoding
+// or packing anything at startup.
+//
+// impossible-rocket-atlas-packer <output directory> <image>...
+// Image paths are stored in the table as given.
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Edge pixels copied around each image, filtering & mipmaps sample them
+// rather than a neighbouring image
+constexpr unsigned int ATLAS_PADDING { 2 };
+constexpr auto HEADER_NAME { "SpriteAtlas.hpp" };
+constexpr auto SOURCE_NAME { "SpriteAtlas.cpp" };
+
+struct Layout {
+    sf::Vector2u size;
+    std::vector<sf::Vector2u> positions; // Padded top left of each image
+};
+
+auto get_padded_size(const sf::Image& image) -> sf::Vector2u
+{
+    return image.getSize() + sf::Vector2u { ATLAS_PADDING * 2, ATLAS_PADDING * 2 };
+}
+
+// Shelf packing, tallest first so each shelf wastes little height. The width
+// is the square that would fit the padded images' area, rounded up to a
+// power of two & wide enough for the widest image.
+auto pack(const std::vector<sf::Image>& images) -> Layout
+{
+    std::vector<std::size_t> order(images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&images](std::size_t a, std::size_t b) {
+        return images[a].getSize().y > images[b].getSize().y;
+    });
+
+    unsigned int area = 0;
+    unsigned int widest = 0;
+    for (const auto& image : images) {
+        const auto padded = get_padded_size(image);
+        area += padded.x * padded.y;
+        widest = std::max(widest, padded.x);
+    }
+
+    Layout layout;
+    layout.size = { 1, 1 };
+    while (layout.size.x * layout.size.x < area || layout.size.x < widest)
+        layout.size.x *= 2;
+
+    layout.positions.resize(images.size());
+    sf::Vector2u cursor;
+    unsigned int shelfHeight = 0;
+    for (const auto i : order) {
+        const auto padded = get_padded_size(images[i]);
+        if (cursor.x + padded.x > layout.size.x) {
+            cursor = { 0, cursor.y + shelfHeight };
+            shelfHeight = 0;
+        }
+        layout.positions[i] = cursor;
+        cursor.x += padded.x;
+        shelfHeight = std::max(shelfHeight, padded.y);
+    }
+
+    while (layout.size.y < cursor.y + shelfHeight)
+        layout.size.y *= 2;
+    return layout;
+}
+
+// Copies the image into the atlas at position & extrudes its edges into the padding
+void blit_padded(sf::Image& atlas, const sf::Image& image, const sf::Vector2u& position)
+{
+    const auto size = image.getSize();
+    const auto padded = get_padded_size(image);
+    for (unsigned int y = 0; y < padded.y; ++y) {
+        const auto sourceY = std::clamp(y, ATLAS_PADDING, size.y + ATLAS_PADDING - 1) - ATLAS_PADDING;
+        for (unsigned int x = 0; x < padded.x; ++x) {
+            const auto sourceX = std::clamp(x, ATLAS_PADDING, size.x + ATLAS_PADDING - 1) - ATLAS_PADDING;
+            atlas.setPixel(position + sf::Vector2u { x, y }, image.getPixel({ sourceX, sourceY }));
+        }
+    }
+}
+
+void write_header(const std::filesystem::path& path,
+                  const std::vector<std::string>& imagePaths,
+                  const std::vector<sf::Image>& images,
+                  const Layout& layout)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to write {}", path.string()));
+
+    file << "// Generated by impossible-rocket-atlas-packer, don't edit\n"
+            "#pragma once\n\n"
+            "#include <array>\n"
+            "#include <cstdint>\n"
+            "#include <string_view>\n\n"
+            "namespace sprite_atlas {\n"
+            "// Where an image sits in the atlas, in pixels like SFML texture coordinates\n"
+            "struct Region {\n"
+            "    std::string_view path;\n"
+            "    int left { 0 };\n"
+            "    int top { 0 };\n"
+            "    int width { 0 };\n"
+            "    int height { 0 };\n"
+            "};\n\n";
+    file << fmt::format("constexpr unsigned int WIDTH {{ {} }};\n", layout.size.x);
+    file << fmt::format("constexpr unsigned int HEIGHT {{ {} }};\n", layout.size.y);
+    file << fmt::format("constexpr std::array<Region, {}> REGIONS {{ {{\n", images.size());
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        const auto position = layout.positions[i] + sf::Vector2u { ATLAS_PADDING, ATLAS_PADDING };
+        file << fmt::format("    {{ \"{}\", {}, {}, {}, {} }},\n",
+                            imagePaths[i],
+                            position.x,
+                            position.y,
+                            images[i].getSize().x,
+                            images[i].getSize().y);
+    }
+    file << "} };\n\n"
+            "// RGBA, row by row\n"
+            "extern const std::uint8_t PIXELS[WIDTH * HEIGHT * 4];\n\n"
+            "constexpr auto find_region(std::string_view path) -> const Region*\n"
+            "{\n"
+            "    for (const auto& region : REGIONS) {\n"
+            "        if (region.path == path)\n"
+            "            return &region;\n"
+            "    }\n"
+            "    return nullptr;\n"
+            "}\n"
+            "}\n";
+
+    if (!file.good())
+        throw std::runtime_error(fmt::format("Unable to write {}", path.string()));
+}
+
+void write_source(const std::filesystem::path& path, const sf::Image& atlas)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to write {}", path.string()));
+
+    file << "// Generated by impossible-rocket-atlas-packer, don't edit\n"
+            "#include \"SpriteAtlas.hpp\"\n\n"
+            "const std::uint8_t sprite_atlas::PIXELS[WIDTH * HEIGHT * 4] = {\n";
+    const auto byteCount = std::size_t { atlas.getSize().x } * atlas.getSize().y * 4;
+    const auto* pixels = atlas.getPixelsPtr();
+    for (std::size_t i = 0; i < byteCount; i += 32) {
+        file << "   ";
+        for (auto j = i; j < std::min(i + 32, byteCount); ++j)
+            file << ' ' << static_cast<unsigned int>(pixels[j]) << ',';
+        file << '\n';
+    }
+    file << "};\n";
+
+    if (!file.good())
+        throw std::runtime_error(fmt::format("Unable to write {}", path.string()));
+}
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 3)
+            throw std::runtime_error("Usage: impossible-rocket-atlas-packer <output directory> <image>...");
+
+        const std::filesystem::path outputDirectory { argv[1] };
+        const std::vector<std::string> imagePaths(argv + 2, argv + argc);
+
+        std::vector<sf::Image> images(imagePaths.size());
+        for (std::size_t i = 0; i < imagePaths.size(); ++i) {
+            if (!images[i].loadFromFile(imagePaths[i]))
+                throw std::runtime_error(fmt::format("Unable to load atlas image {}", imagePaths[i]));
+        }
+
+        const auto layout = pack(images);
+        sf::Image atlas;
+        atlas.create(layout.size, sf::Color::Transparent);
+        for (std::size_t i = 0; i < images.size(); ++i)
+            blit_padded(atlas, images[i], layout.positions[i]);
+
+        std::filesystem::create_directories(outputDirectory);
+        write_header(outputDirectory / HEADER_NAME, imagePaths, images, layout);
+        write_source(outputDirectory / SOURCE_NAME, atlas);
+        spdlog::info("Packed {} images into a {}x{} atlas", images.size(), layout.size.x, layout.size.y);
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
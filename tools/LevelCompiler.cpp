@@ -0,0 +1,32 @@
+// Compiles text levels into the binary format GameLevel maps straight into
+// its arrays, see GameLevel::loadLevel. Each level is written next to its
+// text file as GameLevel::getCompiledPath names it.
+//
+// impossible-rocket-level-compiler <text level>...
+
+#include "GameLevel.hpp"
+
+#include <exception>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 2)
+            throw std::runtime_error("Usage: impossible-rocket-level-compiler <text level>...");
+
+        for (int i = 1; i < argc; ++i) {
+            const std::filesystem::path textPath { argv[i] };
+            const auto compiledPath = GameLevel::getCompiledPath(textPath);
+            GameLevel::compileLevel(textPath, compiledPath);
+            spdlog::info("Compiled {} to {}", textPath.string(), compiledPath.string());
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    return 0;
+}